@@ -0,0 +1,283 @@
+#include "address.hpp"
+#include "bitcoin_utils.hpp"
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include <openssl/ripemd.h>
+#include <openssl/sha.h>
+#include <cctype>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+template <class T, void (*Free)(T*)>
+struct Deleter {
+    void operator()(T* p) const { Free(p); }
+};
+using Group = std::unique_ptr<EC_GROUP, Deleter<EC_GROUP, EC_GROUP_free>>;
+using Point = std::unique_ptr<EC_POINT, Deleter<EC_POINT, EC_POINT_free>>;
+using Ctx = std::unique_ptr<BN_CTX, Deleter<BN_CTX, BN_CTX_free>>;
+using Num = std::unique_ptr<BIGNUM, Deleter<BIGNUM, BN_free>>;
+
+const char* const SCRIPT_NAMES[Address::SCRIPT_TYPES] = {"p2pkh", "p2sh-p2wpkh", "p2wpkh", "p2tr"};
+
+const char BECH32_CHARSET[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+const std::string BECH32_HRP = "bc";
+// Constante final do checksum: bech32 (versão 0) e bech32m (versão 1+)
+const uint32_t BECH32_CONST = 1;
+const uint32_t BECH32M_CONST = 0x2bc830a3;
+
+uint32_t bech32_polymod(const std::vector<uint8_t>& values) {
+    static const uint32_t GENERATOR[5] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa, 0x3d4233dd,
+                                          0x2a1462b3};
+    uint32_t chk = 1;
+    for (uint8_t value : values) {
+        uint32_t top = chk >> 25;
+        chk = ((chk & 0x1ffffff) << 5) ^ value;
+        for (int i = 0; i < 5; i++) {
+            if ((top >> i) & 1) {
+                chk ^= GENERATOR[i];
+            }
+        }
+    }
+    return chk;
+}
+
+std::vector<uint8_t> bech32_hrp_expand(const std::string& hrp) {
+    std::vector<uint8_t> out;
+    for (char c : hrp) out.push_back(static_cast<uint8_t>(c) >> 5);
+    out.push_back(0);
+    for (char c : hrp) out.push_back(static_cast<uint8_t>(c) & 31);
+    return out;
+}
+
+// Reagrupa bits (8 -> 5 na codificação, 5 -> 8 na decodificação)
+bool convert_bits(const std::vector<uint8_t>& in, int from, int to, bool pad,
+                  std::vector<uint8_t>& out) {
+    uint32_t acc = 0;
+    int bits = 0;
+    const uint32_t max = (1u << to) - 1;
+    for (uint8_t value : in) {
+        acc = (acc << from) | value;
+        bits += from;
+        while (bits >= to) {
+            bits -= to;
+            out.push_back(static_cast<uint8_t>((acc >> bits) & max));
+        }
+    }
+    if (pad) {
+        if (bits > 0) out.push_back(static_cast<uint8_t>((acc << (to - bits)) & max));
+    } else if (bits >= from || ((acc << (to - bits)) & max)) {
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint8_t> hash160(const uint8_t* data, size_t size) {
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    SHA256(data, size, digest);
+    std::vector<uint8_t> out(RIPEMD160_DIGEST_LENGTH);
+    RIPEMD160(digest, sizeof(digest), out.data());
+    return out;
+}
+
+// Endereço segwit (hrp bc): versão 0 com bech32, 1 com bech32m
+bool decode_segwit(const std::string& address, uint8_t& version, std::vector<uint8_t>& program) {
+    bool lower = false, upper = false;
+    for (char c : address) {
+        if (c < 33 || c > 126) return false;
+        lower |= c >= 'a' && c <= 'z';
+        upper |= c >= 'A' && c <= 'Z';
+    }
+    if ((lower && upper) || address.size() > 90) return false;
+
+    std::string text;
+    for (char c : address) text += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    size_t separator = text.rfind('1');
+    if (separator == std::string::npos || text.substr(0, separator) != BECH32_HRP ||
+        text.size() - separator - 1 < 7) {
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    for (size_t i = separator + 1; i < text.size(); i++) {
+        const char* pos = std::strchr(BECH32_CHARSET, text[i]);
+        if (pos == nullptr || *pos == '\0') return false;
+        data.push_back(static_cast<uint8_t>(pos - BECH32_CHARSET));
+    }
+
+    std::vector<uint8_t> values = bech32_hrp_expand(BECH32_HRP);
+    values.insert(values.end(), data.begin(), data.end());
+    const uint32_t check = bech32_polymod(values);
+    version = data[0];
+    if (version > 16 || check != (version == 0 ? BECH32_CONST : BECH32M_CONST)) {
+        return false;
+    }
+
+    program.clear();
+    std::vector<uint8_t> payload(data.begin() + 1, data.end() - 6);
+    return convert_bits(payload, 5, 8, false, program) && program.size() >= 2 &&
+           program.size() <= 40;
+}
+
+std::string encode_segwit(uint8_t version, const std::vector<uint8_t>& program) {
+    std::vector<uint8_t> data{version};
+    convert_bits(program, 8, 5, true, data);
+
+    std::vector<uint8_t> values = bech32_hrp_expand(BECH32_HRP);
+    values.insert(values.end(), data.begin(), data.end());
+    values.insert(values.end(), 6, 0);
+    const uint32_t check = bech32_polymod(values) ^ (version == 0 ? BECH32_CONST : BECH32M_CONST);
+
+    std::string out = BECH32_HRP + "1";
+    for (uint8_t value : data) out += BECH32_CHARSET[value];
+    for (int i = 0; i < 6; i++) out += BECH32_CHARSET[(check >> (5 * (5 - i))) & 31];
+    return out;
+}
+
+// Chave de saída BIP341 sem script tree: x(P + tweak * G), P com y par
+std::vector<uint8_t> taproot_output_key(const std::vector<uint8_t>& public_key) {
+    Group group(EC_GROUP_new_by_curve_name(NID_secp256k1));
+    Ctx ctx(BN_CTX_new());
+    if (!group || !ctx) {
+        throw std::runtime_error("Falha ao preparar secp256k1 para o P2TR");
+    }
+    Point internal(EC_POINT_new(group.get())), output(EC_POINT_new(group.get()));
+    Num tweak(BN_new()), one(BN_new()), x(BN_new());
+
+    uint8_t even[33];
+    even[0] = 0x02;
+    std::memcpy(even + 1, public_key.data() + 1, 32);
+    auto hash = Address::tap_tweak(even + 1);
+    BN_bin2bn(hash.data(), 32, tweak.get());
+    BN_one(one.get());
+
+    if (!internal || !output || !tweak || !one || !x ||
+        !EC_POINT_oct2point(group.get(), internal.get(), even, sizeof(even), ctx.get()) ||
+        BN_cmp(tweak.get(), EC_GROUP_get0_order(group.get())) >= 0 ||
+        !EC_POINT_mul(group.get(), output.get(), tweak.get(), internal.get(), one.get(),
+                      ctx.get()) ||
+        !EC_POINT_get_affine_coordinates(group.get(), output.get(), x.get(), nullptr,
+                                         ctx.get())) {
+        throw std::runtime_error("Falha ao calcular a chave de saída P2TR");
+    }
+
+    std::vector<uint8_t> out(32);
+    BN_bn2binpad(x.get(), out.data(), 32);
+    return out;
+}
+
+}  // namespace
+
+const char* Address::name(ScriptType script) {
+    return SCRIPT_NAMES[static_cast<uint32_t>(script)];
+}
+
+ScriptType Address::parse_script(const std::string& text) {
+    for (uint32_t i = 0; i < SCRIPT_TYPES; i++) {
+        if (text == SCRIPT_NAMES[i]) {
+            return static_cast<ScriptType>(i);
+        }
+    }
+    throw std::invalid_argument("Tipo de script desconhecido: " + text +
+                                " (p2pkh, p2sh-p2wpkh, p2wpkh ou p2tr)");
+}
+
+AddressTarget Address::decode(const std::string& address) {
+    AddressTarget target;
+
+    uint8_t version;
+    if (decode_segwit(address, version, target.program)) {
+        if (version == 0 && target.program.size() == 20) {
+            target.script = ScriptType::P2WPKH;
+        } else if (version == 1 && target.program.size() == 32) {
+            target.script = ScriptType::P2TR;
+        } else {
+            throw std::invalid_argument("Endereço segwit não suportado (só P2WPKH e P2TR): " +
+                                        address);
+        }
+        return target;
+    }
+
+    if (address.empty() || address.find_first_not_of(
+            "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz") != std::string::npos ||
+        !BitcoinUtils::is_valid_address(address)) {
+        throw std::invalid_argument("Endereço Bitcoin inválido: " + address);
+    }
+    std::vector<uint8_t> decoded = BitcoinUtils::base58_decode(address);
+    if (decoded[0] == 0x00) {
+        target.script = ScriptType::P2PKH;
+    } else if (decoded[0] == 0x05) {
+        target.script = ScriptType::P2SH_P2WPKH;
+    } else {
+        throw std::invalid_argument("Prefixo de endereço não suportado (só mainnet): " + address);
+    }
+    target.program.assign(decoded.begin() + 1, decoded.begin() + 21);
+    return target;
+}
+
+std::string Address::encode(const AddressTarget& target) {
+    switch (target.script) {
+    case ScriptType::P2PKH:
+    case ScriptType::P2SH_P2WPKH: {
+        std::vector<uint8_t> bytes{static_cast<uint8_t>(target.script == ScriptType::P2PKH ? 0x00
+                                                                                            : 0x05)};
+        bytes.insert(bytes.end(), target.program.begin(), target.program.end());
+        uint8_t first[SHA256_DIGEST_LENGTH], second[SHA256_DIGEST_LENGTH];
+        SHA256(bytes.data(), bytes.size(), first);
+        SHA256(first, sizeof(first), second);
+        bytes.insert(bytes.end(), second, second + 4);
+        return BitcoinUtils::base58_encode(bytes);
+    }
+    case ScriptType::P2WPKH:
+        return encode_segwit(0, target.program);
+    case ScriptType::P2TR:
+        return encode_segwit(1, target.program);
+    }
+    throw std::invalid_argument("Tipo de script inválido");
+}
+
+std::vector<uint8_t> Address::program(ScriptType script, const std::vector<uint8_t>& public_key) {
+    if (public_key.size() != 33) {
+        throw std::invalid_argument("Chave pública comprimida deve ter 33 bytes");
+    }
+    switch (script) {
+    case ScriptType::P2PKH:
+    case ScriptType::P2WPKH:
+        return hash160(public_key.data(), public_key.size());
+    case ScriptType::P2SH_P2WPKH: {
+        // redeem script: OP_0 PUSH20 <hash160>
+        std::vector<uint8_t> redeem{0x00, 0x14};
+        auto key_hash = hash160(public_key.data(), public_key.size());
+        redeem.insert(redeem.end(), key_hash.begin(), key_hash.end());
+        return hash160(redeem.data(), redeem.size());
+    }
+    case ScriptType::P2TR:
+        return taproot_output_key(public_key);
+    }
+    throw std::invalid_argument("Tipo de script inválido");
+}
+
+std::string Address::from_private_key(const std::vector<uint8_t>& private_key, ScriptType script) {
+    AddressTarget target;
+    target.script = script;
+    target.program = program(script, BitcoinUtils::private_to_public(private_key, true));
+    return encode(target);
+}
+
+std::array<uint8_t, 32> Address::tap_tweak(const uint8_t* x) {
+    static const char TAG[] = "TapTweak";
+    uint8_t tag_hash[SHA256_DIGEST_LENGTH];
+    SHA256(reinterpret_cast<const uint8_t*>(TAG), sizeof(TAG) - 1, tag_hash);
+
+    SHA256_CTX sha;
+    SHA256_Init(&sha);
+    SHA256_Update(&sha, tag_hash, sizeof(tag_hash));
+    SHA256_Update(&sha, tag_hash, sizeof(tag_hash));
+    SHA256_Update(&sha, x, 32);
+    std::array<uint8_t, 32> out;
+    SHA256_Final(out.data(), &sha);
+    return out;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Tipos de script de uma chave avaliados na busca. O valor é o bit do tipo
+// nas máscaras de script (JobSpec::DerivationPath::scripts, bip39.cl).
+enum class ScriptType : uint32_t {
+    P2PKH = 0,        // 1...  base58, hash160 da chave pública
+    P2SH_P2WPKH = 1,  // 3...  base58, hash160 do script 0x00 0x14 <hash160>
+    P2WPKH = 2,       // bc1q  bech32, hash160 da chave pública
+    P2TR = 3,         // bc1p  bech32m, chave de saída BIP341 (x, 32 bytes)
+};
+
+// Endereço decodificado: o tipo e o valor que o kernel compara
+struct AddressTarget {
+    ScriptType script = ScriptType::P2PKH;
+    std::vector<uint8_t> program;   // 20 bytes (hash160) ou 32 (x do P2TR)
+};
+
+// Endereços mainnet: base58check (P2PKH, P2SH) e segwit bech32/bech32m
+// (BIP173/BIP350). Um P2SH só pode ser comparado como P2SH-P2WPKH, o script
+// das carteiras BIP49.
+class Address {
+public:
+    static const size_t SCRIPT_TYPES = 4;
+
+    static uint32_t bit(ScriptType script) { return 1u << static_cast<uint32_t>(script); }
+    static const char* name(ScriptType script);
+    // "p2pkh", "p2sh-p2wpkh", "p2wpkh" ou "p2tr"; lança std::invalid_argument
+    static ScriptType parse_script(const std::string& text);
+
+    // Lança std::invalid_argument para endereço inválido ou de tipo não suportado
+    static AddressTarget decode(const std::string& address);
+    static std::string encode(const AddressTarget& target);
+
+    // Valor comparado para a chave pública comprimida (33 bytes)
+    static std::vector<uint8_t> program(ScriptType script, const std::vector<uint8_t>& public_key);
+    static std::string from_private_key(const std::vector<uint8_t>& private_key, ScriptType script);
+
+    // Hash marcado "TapTweak" (BIP341) do x da chave interna, sem script tree
+    static std::array<uint8_t, 32> tap_tweak(const uint8_t* x);
+};
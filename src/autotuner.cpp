@@ -0,0 +1,243 @@
+#include "autotuner.hpp"
+#include "batch_sizer.hpp"
+#include "globals.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Grupos locais a medir: múltiplos do preferido dobrando até o limite, que
+// sempre entra
+std::vector<size_t> local_sizes(size_t multiple, size_t limit) {
+    std::vector<size_t> sizes;
+    for (size_t local = multiple; local < limit; local *= 2) {
+        sizes.push_back(local);
+    }
+    sizes.push_back(limit);
+    return sizes;
+}
+
+} // namespace
+
+std::string TuningCache::key(const cl::Device& device, const std::string& header) {
+    return device.getInfo<CL_DEVICE_NAME>() + "|" + device.getInfo<CL_DRIVER_VERSION>() + "|" +
+           OpenCLManager::kernel_hash(header);
+}
+
+std::map<std::string, std::string> TuningCache::read() const {
+    std::map<std::string, std::string> entries;
+    std::ifstream in(path_);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos) {
+            throw std::runtime_error("Linha inválida em " + path_ + ": " + line);
+        }
+        entries[line.substr(0, tab)] = line.substr(tab + 1);
+    }
+    return entries;
+}
+
+bool TuningCache::find(const std::string& key, LaunchConfig& config, double& rate) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entries = read();
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return false;
+    }
+
+    std::istringstream in(it->second);
+    int persistent = 0, ec_table = 0;
+    LaunchConfig parsed;
+    if (!(in >> persistent >> ec_table >> parsed.local_size >> parsed.groups_per_cu >>
+          parsed.batch >> rate)) {
+        throw std::runtime_error("Configuração inválida em " + path_ + " para " + key);
+    }
+    parsed.persistent = persistent != 0;
+    parsed.ec_table = ec_table != 0;
+    config = parsed;
+    return true;
+}
+
+void TuningCache::store(const std::string& key, const LaunchConfig& config, double rate) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entries = read();
+    std::ostringstream value;
+    value << (config.persistent ? 1 : 0) << " " << (config.ec_table ? 1 : 0) << " "
+          << config.local_size << " " << config.groups_per_cu << " " << config.batch << " "
+          << static_cast<uint64_t>(rate);
+    entries[key] = value.str();
+
+    std::string tmp_path = path_ + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        out << "# dispositivo|driver|hash dos kernels e do job\t"
+            << "persistente tabela_G grupo_local grupos_por_CU lote frases/s\n";
+        for (const auto& entry : entries) {
+            out << entry.first << "\t" << entry.second << "\n";
+        }
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Erro ao gravar " + tmp_path);
+        }
+    }
+    std::filesystem::rename(tmp_path, path_);
+}
+
+Autotuner::Autotuner(const cl::Device& device, const std::string& header, bool checksum,
+                     uint64_t total, const std::vector<uint32_t>& dictionary, double seconds)
+    : device_(device), header_(header), dictionary_(dictionary), checksum_(checksum),
+      total_(total), seconds_(seconds) {
+    if (total == 0 || seconds <= 0.0) {
+        throw std::invalid_argument("Espaço ou tempo de calibração inválido");
+    }
+}
+
+LaunchConfig Autotuner::run(bool allow_persistent, bool allow_table, double& rate,
+                            const OnMeasure& on_measure) {
+    LaunchConfig best;
+    rate = 0.0;
+
+    // Configuração que não roda no dispositivo (falta de recursos) conta
+    // como vazão zero
+    auto consider = [&](SearchProgram& program, const LaunchConfig& config) {
+        double measured = 0.0;
+        try {
+            measured = measure(program, config);
+        } catch (const cl::Error&) {
+        }
+        if (on_measure) {
+            on_measure(config, measured);
+        }
+        if (measured > rate) {
+            best = config;
+            rate = measured;
+        }
+        return measured;
+    };
+
+    for (bool table : {true, false}) {
+        if ((table && !allow_table) || should_exit) {
+            continue;
+        }
+        SearchProgram program(device_, header_, table, dictionary_);
+        if (table && !program.ec_table()) {
+            continue;  // sem memória para a tabela: a variante wNAF vem a seguir
+        }
+
+        for (bool persistent : {true, false}) {
+            if ((persistent && !allow_persistent) || should_exit) {
+                continue;
+            }
+            LaunchConfig base;
+            base.persistent = persistent;
+            base = program.resolve(base, checksum_);
+
+            // Grupo local primeiro, com a grade e o lote padrão
+            LaunchConfig tuned = base;
+            double tuned_rate = -1.0;
+            for (size_t local : local_sizes(program.preferred_multiple(persistent),
+                                            program.max_local(persistent))) {
+                LaunchConfig config = base;
+                config.local_size = local;
+                double measured = consider(program, config);
+                if (measured > tuned_rate) {
+                    tuned = config;
+                    tuned_rate = measured;
+                }
+                if (should_exit) {
+                    break;
+                }
+            }
+
+            // Depois a grade (persistente) ou o lote (filter + verify)
+            std::vector<LaunchConfig> variants;
+            if (persistent) {
+                const size_t resident = program.resident_groups(true);
+                std::set<size_t> groups{1, 2, 4, 8, resident};
+                for (size_t count : groups) {
+                    if (count != tuned.groups_per_cu && count <= std::max<size_t>(8, resident)) {
+                        variants.push_back(tuned);
+                        variants.back().groups_per_cu = count;
+                    }
+                }
+            } else {
+                // Os candidatos do filter ocupam 4 bytes por rank do lote
+                const uint64_t max_alloc = device_.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>();
+                for (uint64_t batch : {tuned.batch / 4, tuned.batch / 2, tuned.batch * 2}) {
+                    if (batch >= tuned.local_size && batch <= UINT32_MAX &&
+                        batch * sizeof(cl_uint) <= max_alloc) {
+                        variants.push_back(tuned);
+                        variants.back().batch = batch;
+                    }
+                }
+            }
+            for (const auto& config : variants) {
+                if (should_exit) {
+                    break;
+                }
+                consider(program, config);
+            }
+        }
+    }
+
+    if (rate <= 0.0) {
+        throw std::runtime_error("Nenhuma configuração de lançamento rodou no dispositivo");
+    }
+    return best;
+}
+
+double Autotuner::measure(SearchProgram& program, const LaunchConfig& config) {
+    uint64_t max_batch = 0;
+    std::unique_ptr<DispatchEngine> engine = program.engine(config, max_batch);
+
+    // Lotes dimensionados como na busca, pela duração de kernel padrão; no
+    // modo compactado o lote da configuração é o limite
+    BatchSizer sizer(BatchSizer::DEFAULT_TARGET_SECONDS, program.min_batch(config), max_batch);
+
+    uint64_t position = 0;
+    uint64_t tested = 0, first_tested = 0;
+    double elapsed = 0.0, first_elapsed = 0.0;
+    size_t completed = 0;
+    const auto start = std::chrono::steady_clock::now();
+    engine->run(
+        [&](RankRange& batch) {
+            std::chrono::duration<double> spent = std::chrono::steady_clock::now() - start;
+            if (spent.count() >= seconds_) {
+                return false;
+            }
+            if (position >= total_) {
+                position = 0;
+            }
+            batch.begin = position;
+            batch.end = position + std::min(sizer.next(), total_ - position);
+            position = batch.end;
+            return true;
+        },
+        [&](const BatchResult& result, double seconds) {
+            // O primeiro lote inclui a primeira execução do kernel com o
+            // pipeline vazio; só conta se for o único
+            if (completed++ == 0) {
+                first_tested = result.batch.size();
+                first_elapsed = seconds;
+            } else {
+                tested += result.batch.size();
+                elapsed += seconds;
+            }
+            sizer.report(result.batch.size(), result.kernel_seconds);
+        });
+
+    if (elapsed > 0.0) {
+        return static_cast<double>(tested) / elapsed;
+    }
+    return first_elapsed > 0.0 ? static_cast<double>(first_tested) / first_elapsed : 0.0;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "opencl_manager.hpp"
+#include "search_program.hpp"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Configurações ajustadas por dispositivo, num arquivo texto com uma linha
+// por chave (TuningCache::key): dispositivo, versão do driver e hash dos
+// kernels com o cabeçalho do job. Uma edição dos kernels, um driver novo ou
+// outro job (checksum, modo passphrase, alvos, caminhos) pede outro ajuste.
+class TuningCache {
+public:
+    explicit TuningCache(std::string path) : path_(std::move(path)) {}
+
+    // "nome|driver|sha256 de kernel/*.cl e do cabeçalho do job"; o custo por
+    // rank depende do job, não só dos kernels
+    static std::string key(const cl::Device& device, const std::string& header);
+
+    // Configuração gravada para a chave; false se não houver (ou se o
+    // arquivo não existir). Lança std::runtime_error para linha inválida.
+    bool find(const std::string& key, LaunchConfig& config, double& rate) const;
+    // Grava (ou troca) a configuração da chave, reescrevendo o arquivo por
+    // um temporário renomeado. Seguro entre threads de dispositivos.
+    void store(const std::string& key, const LaunchConfig& config, double rate);
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::map<std::string, std::string> read() const;
+
+    std::string path_;
+    mutable std::mutex mutex_;
+};
+
+// Ajuste de lançamento de um dispositivo: mede frases enumeradas por segundo
+// em lotes curtos de calibração (ranks do início do espaço, resultados
+// descartados) para cada variante de compilação (tabela de G ou wNAF) e
+// modo permitidos. Em cada modo varre o grupo local em múltiplos de
+// CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE e depois, com o melhor grupo,
+// os grupos por unidade de computação (persistente; inclui quantos cabem na
+// memória local) ou o maior lote (filter + verify). Os lotes medidos têm o
+// tamanho que o BatchSizer escolheria na busca.
+class Autotuner {
+public:
+    // Configuração medida e a vazão dela
+    using OnMeasure = std::function<void(const LaunchConfig&, double rate)>;
+
+    // dictionary: o de SearchProgram (modo passphrase); header e dictionary
+    // precisam viver enquanto o Autotuner existir
+    Autotuner(const cl::Device& device, const std::string& header, bool checksum,
+              uint64_t total, const std::vector<uint32_t>& dictionary, double seconds = 1.5);
+
+    // Melhor configuração entre as permitidas; rate recebe a vazão dela.
+    // Lança std::runtime_error se nenhuma rodar.
+    LaunchConfig run(bool allow_persistent, bool allow_table, double& rate,
+                     const OnMeasure& on_measure = nullptr);
+
+private:
+    double measure(SearchProgram& program, const LaunchConfig& config);
+
+    const cl::Device& device_;
+    const std::string& header_;
+    const std::vector<uint32_t>& dictionary_;
+    bool checksum_;
+    uint64_t total_;
+    double seconds_;
+};
@@ -0,0 +1,40 @@
+#include "batch_sizer.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Peso de uma medida maior na média, para o ruído de um lote não fazer o
+// tamanho oscilar. Uma medida menor (clock caindo) vale na hora: o lote
+// seguinte não pode passar muito do alvo.
+const double RATE_WEIGHT = 0.3;
+// Crescimento máximo por lote: a medida de um lote pequeno inclui o custo
+// do lançamento e subestima a vazão
+const uint64_t MAX_GROWTH = 4;
+const uint64_t INITIAL_UNITS = 16;
+
+} // namespace
+
+BatchSizer::BatchSizer(double target_seconds, uint64_t granularity, uint64_t max_size)
+    : target_(target_seconds), granularity_(granularity), max_size_(max_size) {
+    if (target_seconds <= 0.0 || granularity == 0 || max_size == 0) {
+        throw std::invalid_argument("Alvo ou limites de lote inválidos");
+    }
+    size_ = std::min(max_size_, granularity_ * INITIAL_UNITS);
+}
+
+void BatchSizer::report(uint64_t ranks, double seconds) {
+    if (ranks == 0 || seconds <= 0.0) {
+        return;
+    }
+    const double measured = static_cast<double>(ranks) / seconds;
+    rate_ = rate_ > 0.0 && measured > rate_ ? rate_ + RATE_WEIGHT * (measured - rate_)
+                                            : measured;
+
+    const double wanted = rate_ * target_;
+    uint64_t size = wanted >= static_cast<double>(max_size_) ? max_size_
+                                                             : static_cast<uint64_t>(wanted);
+    size = std::min(size, size_ * MAX_GROWTH);
+    size = std::max(granularity_, size / granularity_ * granularity_);
+    size_ = std::min(size, max_size_);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+// Tamanho dos lotes de um dispositivo para que cada lançamento dure cerca de
+// `target_seconds` de kernel: a vazão medida pelos eventos de profiling
+// vezes o alvo, em múltiplos de `granularity` e até max_size. A estimativa
+// sobe por média móvel e cai na hora, acompanhando o clock (throttling) e
+// mudanças no custo por frase. Lotes curtos demais gastam o tempo em
+// lançamentos; longos demais atrasam o Ctrl-C e o progresso e podem
+// disparar o watchdog do vídeo.
+class BatchSizer {
+public:
+    // Alvo padrão: lançamentos bem acima do custo de enfileirar e bem abaixo
+    // dos ~2 s do watchdog
+    static constexpr double DEFAULT_TARGET_SECONDS = 0.1;
+
+    BatchSizer(double target_seconds, uint64_t granularity, uint64_t max_size);
+
+    // Próximo lote (antes da primeira medida, 16 x granularity)
+    uint64_t next() const { return size_; }
+    // Lote de `ranks` concluído em `seconds` de kernel
+    void report(uint64_t ranks, double seconds);
+
+    double rate() const { return rate_; }  // ranks/s estimados
+
+private:
+    double target_;
+    uint64_t granularity_;
+    uint64_t max_size_;
+    uint64_t size_;
+    double rate_ = 0.0;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include "job_spec.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Resultado de um estágio do pipeline: candidatos processados por segundo
+struct BenchResult {
+    std::string backend;   // openssl, native-avx512, opencl...
+    std::string device;
+    std::string stage;     // enumerate, checksum, pbkdf2, bip32, point_mul, hash160, pipeline
+    uint64_t candidates = 0;
+    double seconds = 0.0;
+    int verified = -1;     // -1 não verificado, 0 diverge do host, 1 confere
+    int64_t private_bytes = -1;  // CL_KERNEL_PRIVATE_MEM_SIZE do kernel, -1 no host
+
+    double rate() const { return seconds > 0.0 ? candidates / seconds : 0.0; }
+};
+
+struct BenchOptions {
+    double min_seconds = 2.0;   // tempo mínimo medido por estágio
+    int device = -1;            // índice do dispositivo OpenCL, -1 = todos
+    bool host = true;
+    bool opencl = true;
+    std::string json_path = "bench.json";
+    std::string job_path;       // vazio = busca padrão (globals.cpp)
+};
+
+// Mede `step` (que retorna quantos candidatos processou) até passar
+// `min_seconds`, depois de uma chamada de aquecimento
+template <class Step>
+BenchResult measure(const std::string& backend, const std::string& device,
+                    const std::string& stage, double min_seconds, Step step) {
+    BenchResult result;
+    result.backend = backend;
+    result.device = device;
+    result.stage = stage;
+
+    step();
+    auto start = std::chrono::steady_clock::now();
+    do {
+        result.candidates += step();
+        result.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    } while (result.seconds < min_seconds);
+    return result;
+}
+
+// bip39_index: índice na wordlist BIP39 completa de cada palavra do pool
+// (vazio sem wordlist). No OpenCL os índices vêm do cabeçalho do job.
+std::vector<BenchResult> run_host_benchmarks(const BenchOptions& options, const JobSpec& job,
+                                             const std::vector<uint16_t>& bip39_index);
+std::vector<BenchResult> run_opencl_benchmarks(const BenchOptions& options, const JobSpec& job);
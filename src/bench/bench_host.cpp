@@ -0,0 +1,295 @@
+#include "bench/bench.hpp"
+#include "bitcoin_utils.hpp"
+#include "bip39_utils.hpp"
+#include "cpu/cpu_search.hpp"
+#include "cpu/pbkdf2_lanes.hpp"
+#include "passphrase_space.hpp"
+#include "search_space.hpp"
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/ripemd.h>
+#include <openssl/sha.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const uint32_t PHRASE_LEN = 12;
+
+// Passo "aleatório" entre ranks para não medir só o caso de next() barato
+const uint64_t RANK_STRIDE = 0x9E3779B97F4A7C15ULL;
+
+std::string phrase_from_indices(const JobSpec& job, const uint32_t* phrase) {
+    std::string mnemonic;
+    for (uint32_t i = 0; i < PHRASE_LEN; i++) {
+        if (i > 0) mnemonic += " ";
+        mnemonic += job.words[phrase[i]];
+    }
+    return mnemonic;
+}
+
+// Frases dos ranks consecutivos a partir de `rank`
+std::vector<std::string> mnemonics_at(const JobSpec& job, const SearchSpace& space,
+                                      uint64_t rank, size_t count) {
+    std::vector<std::string> mnemonics;
+    uint32_t phrase[PHRASE_LEN];
+    for (size_t i = 0; i < count; i++) {
+        space.unrank((rank + i) % space.total(), phrase);
+        mnemonics.push_back(phrase_from_indices(job, phrase));
+    }
+    return mnemonics;
+}
+
+// Menor conjunto de instruções até o detectado (para comparar os três)
+std::vector<SimdIsa> supported_isas() {
+    std::vector<SimdIsa> isas = {SimdIsa::Scalar};
+    SimdIsa best = Pbkdf2Lanes::detect();
+    if (best == SimdIsa::AVX2 || best == SimdIsa::AVX512) {
+        isas.push_back(SimdIsa::AVX2);
+    }
+    if (best == SimdIsa::AVX512) {
+        isas.push_back(SimdIsa::AVX512);
+    }
+    return isas;
+}
+
+// Seeds de referência do OpenSSL para conferir o PBKDF2 nativo
+std::vector<std::array<uint8_t, 64>> openssl_seeds(const std::vector<std::string>& mnemonics,
+                                                   const std::string& passphrase) {
+    const std::string salt = "mnemonic" + passphrase;
+    std::vector<std::array<uint8_t, 64>> seeds(mnemonics.size());
+    for (size_t i = 0; i < mnemonics.size(); i++) {
+        PKCS5_PBKDF2_HMAC(mnemonics[i].data(), static_cast<int>(mnemonics[i].size()),
+                          reinterpret_cast<const unsigned char*>(salt.data()),
+                          static_cast<int>(salt.size()), 2048, EVP_sha512(), 64,
+                          seeds[i].data());
+    }
+    return seeds;
+}
+
+std::string native_backend(SimdIsa isa) {
+    std::string name = Pbkdf2Lanes::name(isa);
+    for (auto& c : name) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return "native-" + name;
+}
+
+}  // namespace
+
+std::vector<BenchResult> run_host_benchmarks(const BenchOptions& options, const JobSpec& job,
+                                             const std::vector<uint16_t>& bip39_index) {
+    std::vector<BenchResult> results;
+    const double seconds = options.min_seconds;
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::string device = "host (1 thread)";
+    const std::string all_threads = "host (" + std::to_string(threads) + " threads)";
+
+    SearchSpace space(job.pool_size, job.slots);
+    volatile uint32_t sink = 0;
+
+    auto report = [&](const BenchResult& result) {
+        std::cout << "  " << result.backend << " " << result.stage << ": "
+                  << static_cast<uint64_t>(result.rate()) << "/s" << std::endl;
+        results.push_back(result);
+    };
+
+    // Enumeração: conversão completa de rank e avanço incremental
+    uint64_t rank = 0;
+    report(measure("host", device, "enumerate_unrank", seconds, [&]() -> uint64_t {
+        uint32_t phrase[PHRASE_LEN];
+        for (int i = 0; i < 4096; i++) {
+            rank = (rank + RANK_STRIDE) % space.total();
+            space.unrank(rank, phrase);
+            sink = sink + phrase[PHRASE_LEN - 1];
+        }
+        return 4096;
+    }));
+
+    uint32_t current[PHRASE_LEN];
+    space.unrank(0, current);
+    report(measure("host", device, "enumerate_next", seconds, [&]() -> uint64_t {
+        for (int i = 0; i < 65536; i++) {
+            if (!space.next(current)) {
+                space.unrank(0, current);
+            }
+        }
+        sink = sink + current[PHRASE_LEN - 1];
+        return 65536;
+    }));
+
+    // Checksum BIP39: 132 bits dos índices, SHA-256 dos 16 bytes de entropia
+    if (!bip39_index.empty()) {
+        report(measure("openssl", device, "checksum", seconds, [&]() -> uint64_t {
+            uint32_t phrase[PHRASE_LEN];
+            for (int i = 0; i < 4096; i++) {
+                rank = (rank + 1) % space.total();
+                space.unrank(rank, phrase);
+
+                uint8_t bytes[17] = {0};
+                uint32_t bit = 0;
+                for (uint32_t w = 0; w < PHRASE_LEN; w++) {
+                    uint32_t index = bip39_index[phrase[w]];
+                    for (int b = 10; b >= 0; b--, bit++) {
+                        if (index & (1u << b)) {
+                            bytes[bit / 8] |= static_cast<uint8_t>(0x80 >> (bit % 8));
+                        }
+                    }
+                }
+                uint8_t digest[SHA256_DIGEST_LENGTH];
+                SHA256(bytes, 16, digest);
+                sink = sink + ((digest[0] >> 4) == (bytes[16] >> 4));
+            }
+            return 4096;
+        }));
+    }
+
+    // PBKDF2-HMAC-SHA512, 2048 iterações
+    auto batch = mnemonics_at(job, space, 0, 64);
+    report(measure("openssl", device, "pbkdf2", seconds, [&]() -> uint64_t {
+        static const char salt[] = "mnemonic";
+        uint8_t seed[64];
+        for (size_t i = 0; i < 16; i++) {
+            PKCS5_PBKDF2_HMAC(batch[i].data(), static_cast<int>(batch[i].size()),
+                              reinterpret_cast<const unsigned char*>(salt), 8,
+                              2048, EVP_sha512(), 64, seed);
+            sink = sink + seed[0];
+        }
+        return 16;
+    }));
+
+    // Cada conjunto SIMD é conferido com o OpenSSL em todos os lanes, sem
+    // passphrase e com uma do maior tamanho aceito: um lane errado faria a
+    // busca em CPU perder acertos sem aviso
+    std::string passphrase;
+    for (size_t i = 0; i < PassphraseSpace::MAX_BYTES; i++) {
+        passphrase += static_cast<char>('!' + i % 94);
+    }
+    const auto expected = openssl_seeds(batch, "");
+    const auto expected_passphrase = openssl_seeds(batch, passphrase);
+
+    for (SimdIsa isa : supported_isas()) {
+        std::vector<std::array<uint8_t, 64>> seeds;
+        BenchResult result =
+            measure(native_backend(isa), device, "pbkdf2", seconds, [&]() -> uint64_t {
+                Pbkdf2Lanes::derive(isa, batch, seeds);
+                sink = sink + seeds[0][0];
+                return batch.size();
+            });
+        Pbkdf2Lanes::derive(isa, batch, seeds);
+        bool ok = seeds == expected;
+        Pbkdf2Lanes::derive(isa, batch, seeds, passphrase);
+        ok = ok && seeds == expected_passphrase;
+        result.verified = ok ? 1 : 0;
+        if (!ok) {
+            std::cerr << "AVISO: pbkdf2 " << native_backend(isa) << " diverge do OpenSSL"
+                      << std::endl;
+        }
+        report(result);
+    }
+
+    // Todas as threads com o melhor conjunto: limite de PBKDF2 da máquina
+    SimdIsa best = Pbkdf2Lanes::detect();
+    if (threads > 1) {
+        report(measure(native_backend(best), all_threads, "pbkdf2", seconds, [&]() -> uint64_t {
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; t++) {
+                workers.emplace_back([&batch, best]() {
+                    std::vector<std::array<uint8_t, 64>> seeds;
+                    Pbkdf2Lanes::derive(best, batch, seeds);
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            return static_cast<uint64_t>(threads) * batch.size();
+        }));
+    }
+
+    // Seeds reais para os estágios seguintes
+    std::vector<std::array<uint8_t, 64>> seeds;
+    Pbkdf2Lanes::derive(best, batch, seeds);
+
+    // BIP32: chave mestra + caminho (implementação de referência)
+    std::vector<std::vector<uint8_t>> keys;
+    for (const auto& seed : seeds) {
+        keys.push_back(BitcoinUtils::derive_private_key(
+            std::vector<uint8_t>(seed.begin(), seed.end()), job.paths.front().indices));
+    }
+    size_t next_seed = 0;
+    report(measure("openssl", device, "bip32", seconds, [&]() -> uint64_t {
+        const auto& seed = seeds[next_seed++ % seeds.size()];
+        auto key = BitcoinUtils::derive_private_key(
+            std::vector<uint8_t>(seed.begin(), seed.end()), job.paths.front().indices);
+        sink = sink + key[0];
+        return 1;
+    }));
+
+    // k * G com o grupo secp256k1 reaproveitado
+    std::vector<std::array<uint8_t, 33>> public_keys(keys.size());
+    {
+        EC_GROUP* group = EC_GROUP_new_by_curve_name(NID_secp256k1);
+        EC_POINT* point = group ? EC_POINT_new(group) : nullptr;
+        BN_CTX* ctx = BN_CTX_new();
+        BIGNUM* k = BN_new();
+        if (!group || !point || !ctx || !k) {
+            BN_free(k);
+            BN_CTX_free(ctx);
+            EC_POINT_free(point);
+            EC_GROUP_free(group);
+            throw std::runtime_error("Falha ao preparar secp256k1 para o benchmark");
+        }
+
+        size_t next_key = 0;
+        report(measure("openssl", device, "point_mul", seconds, [&]() -> uint64_t {
+            for (int i = 0; i < 64; i++) {
+                size_t index = next_key++ % keys.size();
+                BN_bin2bn(keys[index].data(), 32, k);
+                EC_POINT_mul(group, point, k, nullptr, nullptr, ctx);
+                EC_POINT_point2oct(group, point, POINT_CONVERSION_COMPRESSED,
+                                   public_keys[index].data(), 33, ctx);
+            }
+            return 64;
+        }));
+
+        BN_free(k);
+        BN_CTX_free(ctx);
+        EC_POINT_free(point);
+        EC_GROUP_free(group);
+    }
+
+    // hash160 da chave pública comprimida
+    size_t next_key = 0;
+    report(measure("openssl", device, "hash160", seconds, [&]() -> uint64_t {
+        uint8_t digest[SHA256_DIGEST_LENGTH], hash160[RIPEMD160_DIGEST_LENGTH];
+        for (int i = 0; i < 4096; i++) {
+            SHA256(public_keys[next_key++ % public_keys.size()].data(), 33, digest);
+            RIPEMD160(digest, sizeof(digest), hash160);
+            sink = sink + hash160[0];
+        }
+        return 4096;
+    }));
+
+    // Pipeline completo do motor nativo (uma thread), como na busca --cpu.
+    // Com o checksum, ~1 em 16 ranks chega ao PBKDF2: a taxa é de ranks.
+    std::vector<uint16_t> checksum_index = job.checksum ? bip39_index : std::vector<uint16_t>();
+    CpuSearchEngine engine(space, job.words, checksum_index, job.paths, job.targets, job.gap, best);
+    const uint64_t span = checksum_index.empty() ? 64 : 1024;
+    std::vector<uint64_t> hits, samples;
+    uint64_t pipeline_rank = 1;
+    report(measure(native_backend(best), device, "pipeline", seconds, [&]() -> uint64_t {
+        if (pipeline_rank + span > space.total()) {
+            pipeline_rank = 0;
+        }
+        RankRange range{pipeline_rank, std::min(pipeline_rank + span, space.total())};
+        pipeline_rank = range.end;
+        engine.search(range, hits, samples);
+        return range.size();
+    }));
+
+    return results;
+}
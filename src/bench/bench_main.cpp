@@ -0,0 +1,148 @@
+// Benchmark por estágio do pipeline (enumeração, checksum, PBKDF2, BIP32,
+// point_mul, hash160) no host e em cada dispositivo OpenCL. Resultado em
+// candidatos/s, impresso e gravado em JSON para comparar entre versões e
+// máquinas.
+#include "bench/bench.hpp"
+#include "bitcoin_utils.hpp"
+#include "cpu/pbkdf2_lanes.hpp"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+void print_usage(const char* program) {
+    std::cout << "Uso: " << program << " [opções]\n"
+              << "  --seconds S   tempo mínimo medido por estágio (padrão 2)\n"
+              << "  --json FILE   arquivo de saída (padrão bench.json)\n"
+              << "  --job FILE    job da busca (padrão: valores de globals.cpp)\n"
+              << "  --device N    apenas o dispositivo OpenCL N\n"
+              << "  --no-host     pular os estágios do host\n"
+              << "  --no-opencl   pular os estágios OpenCL" << std::endl;
+}
+
+BenchOptions parse_options(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc) {
+            options.min_seconds = std::stod(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            options.json_path = argv[++i];
+        } else if (arg == "--job" && i + 1 < argc) {
+            options.job_path = argv[++i];
+        } else if (arg == "--device" && i + 1 < argc) {
+            options.device = std::stoi(argv[++i]);
+        } else if (arg == "--no-host") {
+            options.host = false;
+        } else if (arg == "--no-opencl") {
+            options.opencl = false;
+        } else if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            std::exit(0);
+        } else {
+            print_usage(argv[0]);
+            throw std::invalid_argument("Opção desconhecida: " + arg);
+        }
+    }
+    if (options.min_seconds <= 0.0) {
+        throw std::invalid_argument("--seconds deve ser positivo");
+    }
+    return options;
+}
+
+// Índice de cada palavra do pool na wordlist BIP39 completa (para o
+// checksum); sem a wordlist, vazio e o job segue sem filtro de checksum
+std::vector<uint16_t> load_bip39_index(JobSpec& job) {
+    try {
+        return job.wordlist_indices();
+    } catch (const std::exception& e) {
+        std::cerr << "Checksum não será medido: " << e.what() << std::endl;
+        job.checksum = false;
+        return {};
+    }
+}
+
+std::string json_string(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        if (static_cast<unsigned char>(c) >= 0x20) {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+void write_json(const std::string& path, const BenchOptions& options,
+                const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Não foi possível gravar " + path);
+    }
+
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n"
+        << "  \"version\": 1,\n"
+        << "  \"timestamp\": " << json_string(timestamp) << ",\n"
+        << "  \"min_seconds\": " << options.min_seconds << ",\n"
+        << "  \"host_threads\": " << std::max(1u, std::thread::hardware_concurrency()) << ",\n"
+        << "  \"host_simd\": " << json_string(Pbkdf2Lanes::name(Pbkdf2Lanes::detect())) << ",\n"
+        << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        out << (i ? ",\n" : "\n")
+            << "    {\"backend\": " << json_string(r.backend)
+            << ", \"device\": " << json_string(r.device)
+            << ", \"stage\": " << json_string(r.stage)
+            << ", \"candidates\": " << r.candidates
+            << ", \"seconds\": " << r.seconds
+            << ", \"candidates_per_second\": " << r.rate()
+            << ", \"verified\": " << (r.verified < 0 ? "null" : (r.verified ? "true" : "false"))
+            << ", \"private_mem_bytes\": "
+            << (r.private_bytes < 0 ? "null" : std::to_string(r.private_bytes))
+            << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        BenchOptions options = parse_options(argc, argv);
+        JobSpec job = options.job_path.empty() ? JobSpec::defaults()
+                                               : JobSpec::load(options.job_path);
+        auto bip39_index = load_bip39_index(job);
+        std::vector<BenchResult> results;
+
+        if (options.host) {
+            std::cout << "\nHost (" << Pbkdf2Lanes::name(Pbkdf2Lanes::detect()) << ")" << std::endl;
+            results = run_host_benchmarks(options, job, bip39_index);
+        }
+        if (options.opencl) {
+            auto device_results = run_opencl_benchmarks(options, job);
+            results.insert(results.end(), device_results.begin(), device_results.end());
+        }
+
+        write_json(options.json_path, options, results);
+        std::cout << "\nResultados gravados em " << options.json_path << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+}
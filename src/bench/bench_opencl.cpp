@@ -0,0 +1,363 @@
+#include "bench/bench.hpp"
+#include "opencl_manager.hpp"
+#include "bitcoin_utils.hpp"
+#include "bip39_utils.hpp"
+#include "ec_table.hpp"
+#include "search_space.hpp"
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const uint32_t PHRASE_LEN = 12;
+
+// Rank inicial dos estágios (módulo o total): longe do início para não
+// medir só frases com prefixo repetido
+const uint64_t RANK_OFFSET = 123456789012345ULL;
+
+// Tempo de execução no dispositivo (eventos de profiling), sem o overhead
+// de enfileiramento do host. local = 0 deixa o grupo local com o driver.
+BenchResult time_kernel(OpenCLManager& manager, cl::Kernel& kernel, size_t items,
+                        const std::string& device, const std::string& stage,
+                        double min_seconds, size_t local = 0) {
+    BenchResult result;
+    result.backend = "opencl";
+    result.device = device;
+    result.stage = stage;
+    result.private_bytes = kernel.getWorkGroupInfo<CL_KERNEL_PRIVATE_MEM_SIZE>(manager.device);
+
+    const cl::NDRange local_range = local ? cl::NDRange(local) : cl::NullRange;
+    manager.queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(items), local_range);
+    manager.queue.finish();
+
+    while (result.seconds < min_seconds) {
+        cl::Event event;
+        manager.queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(items),
+                                           local_range, nullptr, &event);
+        event.wait();
+        cl_ulong start = event.getProfilingInfo<CL_PROFILING_COMMAND_START>();
+        cl_ulong end = event.getProfilingInfo<CL_PROFILING_COMMAND_END>();
+        result.seconds += (end - start) * 1e-9;
+        result.candidates += items;
+    }
+
+    std::cout << "  opencl " << stage << ": "
+              << static_cast<uint64_t>(result.rate()) << "/s, "
+              << result.private_bytes << " B privados" << std::endl;
+    return result;
+}
+
+// hash160 do primeiro rank calculado no host, no formato de palavras do kernel
+std::array<uint32_t, 5> host_hash160(const JobSpec& job, const SearchSpace& space,
+                                     uint64_t rank) {
+    auto phrase = space.unrank(rank);
+    std::string mnemonic;
+    for (uint32_t i = 0; i < PHRASE_LEN; i++) {
+        if (i > 0) mnemonic += " ";
+        mnemonic += job.words[phrase[i]];
+    }
+
+    auto seed = BIP39Utils::mnemonic_to_seed(mnemonic);
+    auto key = BitcoinUtils::derive_private_key(seed, job.paths.front().indices);
+    auto address = BitcoinUtils::derive_address(key);
+    return BitcoinUtils::hash160_to_words(BitcoinUtils::address_to_hash160(address));
+}
+
+// Casos conhecidos do k * P com P variável (bench_point_mul_var), com a
+// resposta do OpenSSL: escalares nas bordas da decomposição GLV (1, n - 1,
+// λ, n/2, 2^128...) e aleatórios, com P = G ou múltiplos aleatórios de G.
+// Tudo em limbs little-endian de 32 bits, como em ec.cl.
+struct GlvCases {
+    std::vector<cl_uint> keys;      // 8 por caso
+    std::vector<cl_uint> points;    // x, y de P
+    std::vector<cl_uint> expected;  // x, y de k * P
+    size_t count() const { return keys.size() / 8; }
+};
+
+GlvCases glv_known_answers() {
+    struct Free {
+        void operator()(EC_GROUP* p) const { EC_GROUP_free(p); }
+        void operator()(EC_POINT* p) const { EC_POINT_free(p); }
+        void operator()(BN_CTX* p) const { BN_CTX_free(p); }
+        void operator()(BIGNUM* p) const { BN_free(p); }
+    };
+    std::unique_ptr<EC_GROUP, Free> group(EC_GROUP_new_by_curve_name(NID_secp256k1));
+    std::unique_ptr<BN_CTX, Free> ctx(BN_CTX_new());
+    if (!group || !ctx) {
+        throw std::runtime_error("Falha ao preparar secp256k1 para o GLV");
+    }
+    const BIGNUM* order = EC_GROUP_get0_order(group.get());
+    std::unique_ptr<EC_POINT, Free> base(EC_POINT_new(group.get())), product(EC_POINT_new(group.get()));
+    std::unique_ptr<BIGNUM, Free> k(BN_new()), scalar(BN_new()), x(BN_new()), y(BN_new());
+
+    auto append = [&](std::vector<cl_uint>& out, const BIGNUM* value) {
+        unsigned char bytes[32];
+        BN_bn2binpad(value, bytes, sizeof(bytes));
+        for (int i = 0; i < 8; i++) {
+            const unsigned char* b = bytes + 28 - 4 * i;
+            out.push_back((cl_uint(b[0]) << 24) | (cl_uint(b[1]) << 16) | (cl_uint(b[2]) << 8) | b[3]);
+        }
+    };
+    auto append_point = [&](std::vector<cl_uint>& out, const EC_POINT* point) {
+        EC_POINT_get_affine_coordinates(group.get(), point, x.get(), y.get(), ctx.get());
+        append(out, x.get());
+        append(out, y.get());
+    };
+
+    const char* edges[] = {
+        "1", "2", "3", "F", "10", "11",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F",
+        "5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72",
+        "5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD73",
+        "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5D576E7357A4501DDFE92F46681B20A0",
+        "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5D576E7357A4501DDFE92F46681B20A1",
+        "100000000000000000000000000000000",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+    };
+    const size_t edge_count = sizeof(edges) / sizeof(edges[0]);
+    const size_t total = 64;
+
+    GlvCases cases;
+    std::mt19937_64 rng(17);
+    for (size_t i = 0; i < total; i++) {
+        BIGNUM* raw = k.get();
+        if (i < edge_count) {
+            BN_hex2bn(&raw, edges[i]);
+        } else {
+            unsigned char bytes[32];
+            for (auto& b : bytes) b = static_cast<unsigned char>(rng());
+            BN_bin2bn(bytes, sizeof(bytes), k.get());
+            BN_nnmod(k.get(), k.get(), order, ctx.get());
+            if (BN_is_zero(k.get())) BN_one(k.get());
+        }
+        // P = G nos primeiros casos, senão um múltiplo aleatório de G
+        if (i % 3 == 0) {
+            EC_POINT_copy(base.get(), EC_GROUP_get0_generator(group.get()));
+        } else {
+            BN_set_word(scalar.get(), rng() | 1);
+            EC_POINT_mul(group.get(), base.get(), scalar.get(), nullptr, nullptr, ctx.get());
+        }
+        if (!EC_POINT_mul(group.get(), product.get(), nullptr, base.get(), k.get(), ctx.get())) {
+            throw std::runtime_error("Falha no EC_POINT_mul de referência do GLV");
+        }
+        append(cases.keys, k.get());
+        append_point(cases.points, base.get());
+        append_point(cases.expected, product.get());
+    }
+    return cases;
+}
+
+std::vector<BenchResult> bench_device(const cl::Device& device, const BenchOptions& options,
+                                      const JobSpec& job, uint64_t rank_offset,
+                                      const std::array<uint32_t, 5>& expected) {
+    std::vector<BenchResult> results;
+    const std::string name = OpenCLManager::describe(device);
+    const double seconds = options.min_seconds;
+    std::cout << "\nOpenCL: " << name << std::endl;
+
+    // point_mul_group usa a tabela fixa de G quando o device comporta
+    const bool ec_table = device.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>() >= EcTable::bytes();
+    OpenCLManager manager;
+    manager.initialize(device, CL_QUEUE_PROFILING_ENABLE);
+    manager.loadKernels("bench.cl", job.kernel_header(), ec_table ? "-D EC_FIXED_BASE=1" : "");
+
+    // Estágios leves com muitos itens; os pesados com alguns por unidade de
+    // computação para cada lançamento durar pouco também em CPU (PoCL)
+    const size_t light_items = 1 << 20;
+    const size_t units = device.getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>();
+    const bool is_cpu = (device.getInfo<CL_DEVICE_TYPE>() & CL_DEVICE_TYPE_CPU) != 0;
+    const size_t heavy_items = std::max<size_t>(1, units) * (is_cpu ? 16 : 1024);
+
+    cl::Buffer out(manager.context, CL_MEM_WRITE_ONLY, sizeof(cl_uint) * light_items);
+    cl::Buffer seeds(manager.context, CL_MEM_READ_WRITE, sizeof(cl_ulong) * 8 * heavy_items);
+    cl::Buffer keys(manager.context, CL_MEM_READ_WRITE, sizeof(cl_uint) * 8 * heavy_items);
+    cl::Buffer points(manager.context, CL_MEM_READ_WRITE, sizeof(cl_uint) * 16 * heavy_items);
+    cl::Buffer points_group(manager.context, CL_MEM_READ_WRITE,
+                            sizeof(cl_uint) * 16 * heavy_items);
+    cl::Buffer points_var(manager.context, CL_MEM_WRITE_ONLY, sizeof(cl_uint) * 16 * heavy_items);
+    cl::Buffer table = ec_table
+        ? cl::Buffer(manager.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, EcTable::bytes(),
+                     const_cast<uint32_t*>(EcTable::generator().data()))
+        : cl::Buffer(manager.context, CL_MEM_READ_ONLY, sizeof(cl_uint));
+    cl::Buffer hashes(manager.context, CL_MEM_WRITE_ONLY, sizeof(cl_uint) * 5 * heavy_items);
+    cl::Buffer path(manager.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                    sizeof(cl_uint) * job.paths.front().indices.size(),
+                    const_cast<uint32_t*>(job.paths.front().indices.data()));
+
+    cl::Kernel enumerate(manager.program, "bench_enumerate");
+    enumerate.setArg(0, static_cast<cl_ulong>(rank_offset));
+    enumerate.setArg(1, out);
+    results.push_back(time_kernel(manager, enumerate, light_items, name, "enumerate_unrank", seconds));
+
+    if (job.checksum) {
+        cl::Kernel checksum(manager.program, "bench_checksum");
+        checksum.setArg(0, static_cast<cl_ulong>(rank_offset));
+        checksum.setArg(1, out);
+        results.push_back(time_kernel(manager, checksum, light_items, name, "checksum", seconds));
+    }
+
+    // PBKDF2 anterior (string + blocos inner/outer inteiros), para comparar
+    // memória privada e velocidade; a seed do primeiro item deve ser igual
+    std::array<cl_ulong, 8> legacy_seed;
+    cl::Kernel pbkdf2_legacy(manager.program, "bench_pbkdf2_legacy");
+    pbkdf2_legacy.setArg(0, static_cast<cl_ulong>(rank_offset));
+    pbkdf2_legacy.setArg(1, seeds);
+    results.push_back(time_kernel(manager, pbkdf2_legacy, heavy_items, name, "pbkdf2_legacy",
+                                  seconds));
+    manager.queue.enqueueReadBuffer(seeds, CL_TRUE, 0, sizeof(legacy_seed), legacy_seed.data());
+    const size_t legacy = results.size() - 1;
+
+    // Cadeia seed -> chave -> ponto -> hash160: cada estágio usa a saída real do anterior
+    std::array<cl_ulong, 8> seed;
+    cl::Kernel pbkdf2(manager.program, "bench_pbkdf2");
+    pbkdf2.setArg(0, static_cast<cl_ulong>(rank_offset));
+    pbkdf2.setArg(1, seeds);
+    results.push_back(time_kernel(manager, pbkdf2, heavy_items, name, "pbkdf2", seconds));
+    manager.queue.enqueueReadBuffer(seeds, CL_TRUE, 0, sizeof(seed), seed.data());
+
+    cl::Kernel bip32(manager.program, "bench_bip32");
+    bip32.setArg(0, seeds);
+    bip32.setArg(1, path);
+    bip32.setArg(2, static_cast<cl_uint>(job.paths.front().indices.size()));
+    bip32.setArg(3, keys);
+    results.push_back(time_kernel(manager, bip32, heavy_items, name, "bip32", seconds));
+
+    cl::Kernel point_mul(manager.program, "bench_point_mul");
+    point_mul.setArg(0, keys);
+    point_mul.setArg(1, points);
+    results.push_back(time_kernel(manager, point_mul, heavy_items, name, "point_mul", seconds));
+
+    // A mesma multiplicação como nos kernels de busca: uma inversão por
+    // grupo (truque de Montgomery em memória local) e a tabela fixa de G;
+    // grupo local potência de 2 que divide o lote
+    cl::Kernel point_mul_group(manager.program, "bench_point_mul_group");
+    point_mul_group.setArg(0, keys);
+    point_mul_group.setArg(1, points_group);
+    point_mul_group.setArg(2, table);
+    const size_t max_group = std::min<size_t>(
+        256, point_mul_group.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(device));
+    size_t group = 1;
+    while (group * 2 <= max_group && heavy_items % (group * 2) == 0) {
+        group *= 2;
+    }
+    results.push_back(time_kernel(manager, point_mul_group, heavy_items, name,
+                                  ec_table ? "point_mul_group_table" : "point_mul_group",
+                                  seconds, group));
+    const size_t grouped = results.size() - 1;
+
+    // k * P com P variável (GLV) sobre os pontos do point_mul; o resultado
+    // é conferido com o OpenSSL em glv_known_answers
+    cl::Kernel point_mul_var(manager.program, "bench_point_mul_var");
+    point_mul_var.setArg(0, keys);
+    point_mul_var.setArg(1, points);
+    point_mul_var.setArg(2, points_var);
+    results.push_back(time_kernel(manager, point_mul_var, heavy_items, name, "point_mul_glv",
+                                  seconds));
+    const size_t glv = results.size() - 1;
+
+    const GlvCases cases = glv_known_answers();
+    std::vector<cl_uint> glv_points(cases.expected.size());
+    {
+        cl::Buffer case_keys(manager.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                             sizeof(cl_uint) * cases.keys.size(),
+                             const_cast<cl_uint*>(cases.keys.data()));
+        cl::Buffer case_points(manager.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                               sizeof(cl_uint) * cases.points.size(),
+                               const_cast<cl_uint*>(cases.points.data()));
+        cl::Buffer case_out(manager.context, CL_MEM_WRITE_ONLY,
+                            sizeof(cl_uint) * glv_points.size());
+        point_mul_var.setArg(0, case_keys);
+        point_mul_var.setArg(1, case_points);
+        point_mul_var.setArg(2, case_out);
+        manager.queue.enqueueNDRangeKernel(point_mul_var, cl::NullRange,
+                                           cl::NDRange(cases.count()), cl::NullRange);
+        manager.queue.enqueueReadBuffer(case_out, CL_TRUE, 0,
+                                        sizeof(cl_uint) * glv_points.size(), glv_points.data());
+    }
+
+    std::vector<cl_uint> affine(16 * heavy_items), affine_group(16 * heavy_items);
+    manager.queue.enqueueReadBuffer(points, CL_TRUE, 0, sizeof(cl_uint) * affine.size(),
+                                    affine.data());
+    manager.queue.enqueueReadBuffer(points_group, CL_TRUE, 0,
+                                    sizeof(cl_uint) * affine_group.size(), affine_group.data());
+
+    cl::Kernel hash160(manager.program, "bench_hash160");
+    hash160.setArg(0, points);
+    hash160.setArg(1, hashes);
+    results.push_back(time_kernel(manager, hash160, heavy_items, name, "hash160", seconds));
+
+    // Conferir o primeiro item da cadeia com o host: velocidade de um
+    // kernel que calcula errado não serve como referência
+    std::array<uint32_t, 5> computed;
+    manager.queue.enqueueReadBuffer(hashes, CL_TRUE, 0, sizeof(cl_uint) * 5, computed.data());
+    bool ok = computed == expected;
+    for (auto& result : results) {
+        result.verified = ok ? 1 : 0;
+    }
+    if (!ok) {
+        std::cerr << "AVISO: hash160 de " << name << " diverge do host" << std::endl;
+    }
+    if (affine_group != affine) {
+        results[grouped].verified = 0;
+        std::cerr << "AVISO: point_mul_group de " << name << " diverge" << std::endl;
+    }
+    if (glv_points != cases.expected) {
+        results[glv].verified = 0;
+        std::cerr << "AVISO: point_mul_glv de " << name << " diverge do OpenSSL" << std::endl;
+    }
+    if (legacy_seed != seed) {
+        results[legacy].verified = 0;
+        std::cerr << "AVISO: seed do pbkdf2_legacy de " << name << " diverge" << std::endl;
+    }
+
+    return results;
+}
+
+}  // namespace
+
+std::vector<BenchResult> run_opencl_benchmarks(const BenchOptions& options, const JobSpec& job) {
+    std::vector<BenchResult> results;
+
+    // Todos os tipos: em máquinas só com CPU o PoCL aparece como CL_DEVICE_TYPE_CPU
+    auto devices = OpenCLManager::discover_devices(CL_DEVICE_TYPE_ALL);
+    if (devices.empty()) {
+        std::cout << "\nNenhum dispositivo OpenCL encontrado" << std::endl;
+        return results;
+    }
+    if (options.device >= static_cast<int>(devices.size())) {
+        throw std::invalid_argument("Dispositivo OpenCL inexistente: " +
+                                    std::to_string(options.device));
+    }
+
+    SearchSpace space(job.pool_size, job.slots);
+    uint64_t rank_offset = RANK_OFFSET % space.total();
+    auto expected = host_hash160(job, space, rank_offset);
+
+    for (size_t i = 0; i < devices.size(); i++) {
+        if (options.device >= 0 && static_cast<size_t>(options.device) != i) {
+            continue;
+        }
+        try {
+            auto device_results = bench_device(devices[i], options, job, rank_offset, expected);
+            results.insert(results.end(), device_results.begin(), device_results.end());
+        } catch (const cl::Error& e) {
+            std::cerr << "Erro OpenCL em " << OpenCLManager::describe(devices[i]) << ": "
+                      << e.what() << " (" << e.err() << ")" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Erro em " << OpenCLManager::describe(devices[i]) << ": "
+                      << e.what() << std::endl;
+        }
+    }
+
+    return results;
+}
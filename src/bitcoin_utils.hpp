@@ -68,6 +68,32 @@ public:
                          decoded.end() - 4);
     }
 
+    // Decodificar um endereço P2PKH (base58check) para o hash160 de 20 bytes
+    static std::vector<uint8_t> address_to_hash160(const std::string& address) {
+        if(!is_valid_address(address)) {
+            throw std::invalid_argument("Endereço Bitcoin inválido: " + address);
+        }
+
+        std::vector<uint8_t> decoded = base58_decode(address);
+        if(decoded[0] != 0x00) {
+            throw std::invalid_argument("Apenas endereços P2PKH (prefixo 1) são suportados: " + address);
+        }
+
+        return std::vector<uint8_t>(decoded.begin() + 1, decoded.begin() + 21);
+    }
+
+    // hash160 em 5 words little-endian, formato comparado pelo kernel
+    static std::array<uint32_t, 5> hash160_to_words(const std::vector<uint8_t>& hash160) {
+        std::array<uint32_t, 5> words{};
+        for(size_t i = 0; i < 5; i++) {
+            words[i] = static_cast<uint32_t>(hash160[i * 4]) |
+                       (static_cast<uint32_t>(hash160[i * 4 + 1]) << 8) |
+                       (static_cast<uint32_t>(hash160[i * 4 + 2]) << 16) |
+                       (static_cast<uint32_t>(hash160[i * 4 + 3]) << 24);
+        }
+        return words;
+    }
+
     // Gerar endereço Bitcoin a partir da chave privada
     static std::string derive_address(const std::vector<uint8_t>& private_key) {
         try {
@@ -115,8 +141,15 @@ public:
         return {private_key, chain_code};
     }
 
-    // Mover para a seção pública
-    static std::vector<uint8_t> derive_private_key(const std::vector<uint8_t>& seed) {
+    // Derivar a chave privada do caminho informado (padrão m/44'/0'/0'/0/0)
+    static std::vector<uint8_t> derive_private_key(const std::vector<uint8_t>& seed,
+                                                   const std::vector<uint32_t>& path = {
+                                                       0x8000002C,  // 44' (hardened)
+                                                       0x80000000,  // 0'  (hardened)
+                                                       0x80000000,  // 0'  (hardened)
+                                                       0,           // 0   (normal)
+                                                       0            // 0   (normal)
+                                                   }) {
         try {
             // 1. Gerar master key usando HMAC-SHA512 com "Bitcoin seed"
             const std::string key = "Bitcoin seed";
@@ -131,19 +164,10 @@ public:
             std::vector<uint8_t> master_key(master.begin(), master.begin() + 32);
             std::vector<uint8_t> chain_code(master.begin() + 32, master.end());
 
-            // 3. Derivar caminho m/44'/0'/0'/0/0 (BIP44 completo)
+            // 3. Derivar o caminho (BIP44 completo por padrão)
             auto current_key = master_key;
             auto current_chain = chain_code;
 
-            // Derivar cada nível do caminho
-            std::vector<uint32_t> path = {
-                0x8000002C,  // 44' (hardened)
-                0x80000000,  // 0'  (hardened)
-                0x80000000,  // 0'  (hardened)
-                0,           // 0   (normal)
-                0            // 0   (normal)
-            };
-
             for (uint32_t index : path) {
                 std::vector<uint8_t> data;
                 data.reserve(37);
@@ -231,6 +255,9 @@ public:
     }
 
 private:
+    // Address (address.cpp) usa base58 e a chave pública daqui
+    friend class Address;
+
     static uint8_t hex_value(char hex_digit) {
         if(hex_digit >= '0' && hex_digit <= '9') return hex_digit - '0';
         if(hex_digit >= 'a' && hex_digit <= 'f') return hex_digit - 'a' + 10;
@@ -0,0 +1,267 @@
+#include "cpu/cpu_search.hpp"
+#include "bitcoin_utils.hpp"
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/ripemd.h>
+#include <openssl/sha.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+CpuSearchEngine::CpuSearchEngine(const SearchSpace& space,
+                                 const std::vector<std::string>& words,
+                                 const std::vector<uint16_t>& bip39_index,
+                                 const std::vector<JobSpec::DerivationPath>& paths,
+                                 const std::vector<std::string>& targets,
+                                 uint32_t gap, SimdIsa isa)
+    : space_(space), words_(words), bip39_index_(bip39_index), paths_(paths), gap_(gap),
+      keys_per_phrase_(paths.size() * (gap ? 2 * gap : 1)), isa_(isa) {
+    if (words.size() < space.pool_size()) {
+        throw std::invalid_argument("Lista de palavras não corresponde ao espaço de busca");
+    }
+    if (!bip39_index_.empty() && bip39_index_.size() != words.size()) {
+        throw std::invalid_argument("Índices BIP39 não correspondem à lista de palavras");
+    }
+    size_t depth = 0;
+    for (const auto& path : paths_) {
+        depth = std::max(depth, path.indices.size());
+    }
+    // Com gap, mais dois níveis: cadeia e índice
+    keys_.resize(depth + (gap_ ? 3 : 1));
+    chains_.resize(depth + (gap_ ? 3 : 1));
+    for (const auto& target : targets) {
+        targets_.push_back(Address::decode(target));
+    }
+    mnemonics_.reserve(GROUP_SIZE);
+    ranks_.reserve(GROUP_SIZE);
+
+    group_.reset(EC_GROUP_new_by_curve_name(NID_secp256k1));
+    ctx_.reset(BN_CTX_new());
+    order_.reset(BN_new());
+    key_.reset(BN_new());
+    tweak_.reset(BN_new());
+    one_.reset(BN_new());
+    if (group_) {
+        point_.reset(EC_POINT_new(group_.get()));
+        internal_.reset(EC_POINT_new(group_.get()));
+    }
+    if (!group_ || !ctx_ || !order_ || !key_ || !tweak_ || !one_ || !point_ || !internal_ ||
+        !BN_one(one_.get()) || !EC_GROUP_get_order(group_.get(), order_.get(), ctx_.get())) {
+        throw std::runtime_error("Falha ao preparar secp256k1 para a busca em CPU");
+    }
+}
+
+void CpuSearchEngine::public_key(const uint8_t* private_key, uint8_t* out) {
+    BN_bin2bn(private_key, 32, key_.get());
+    if (!EC_POINT_mul(group_.get(), point_.get(), key_.get(), nullptr, nullptr, ctx_.get()) ||
+        EC_POINT_point2oct(group_.get(), point_.get(), POINT_CONVERSION_COMPRESSED,
+                           out, 33, ctx_.get()) != 33) {
+        throw std::runtime_error("Falha na multiplicação do ponto EC");
+    }
+}
+
+void CpuSearchEngine::derive_child(const uint8_t* key, const uint8_t* chain, uint32_t index,
+                                   uint8_t* child_key, uint8_t* child_chain,
+                                   const uint8_t* parent_pub) {
+    uint8_t data[37], I[64];
+    unsigned int len = 64;
+    if (index & 0x80000000) {
+        data[0] = 0x00;
+        std::memcpy(data + 1, key, 32);
+    } else if (parent_pub) {
+        std::memcpy(data, parent_pub, 33);
+    } else {
+        public_key(key, data);
+    }
+    data[33] = static_cast<uint8_t>(index >> 24);
+    data[34] = static_cast<uint8_t>(index >> 16);
+    data[35] = static_cast<uint8_t>(index >> 8);
+    data[36] = static_cast<uint8_t>(index);
+
+    HMAC(EVP_sha512(), chain, 32, data, 37, I, &len);
+
+    // filho = (IL + pai) mod n
+    BN_bin2bn(I, 32, tweak_.get());
+    BN_bin2bn(key, 32, key_.get());
+    BN_mod_add(key_.get(), key_.get(), tweak_.get(), order_.get(), ctx_.get());
+    std::memset(child_key, 0, 32);
+    BN_bn2bin(key_.get(), child_key + (32 - BN_num_bytes(key_.get())));
+    std::memcpy(child_chain, I + 32, 32);
+}
+
+void CpuSearchEngine::script_program(ScriptType script, const uint8_t* pub,
+                                     std::vector<uint8_t>& out) {
+    uint8_t digest[32];
+    out.resize(20);
+    SHA256(pub, 33, digest);
+    RIPEMD160(digest, 32, out.data());
+    if (script == ScriptType::P2SH_P2WPKH) {
+        // redeem script: OP_0 PUSH20 <hash160>
+        uint8_t redeem[22] = {0x00, 0x14};
+        std::memcpy(redeem + 2, out.data(), 20);
+        SHA256(redeem, sizeof(redeem), digest);
+        RIPEMD160(digest, 32, out.data());
+    } else if (script == ScriptType::P2TR) {
+        // Q = P + t * G, P com y par (BIP341 sem script tree)
+        uint8_t even[33];
+        even[0] = 0x02;
+        std::memcpy(even + 1, pub + 1, 32);
+        auto tweak = Address::tap_tweak(even + 1);
+        BN_bin2bn(tweak.data(), 32, tweak_.get());
+        out.resize(32);
+        if (!EC_POINT_oct2point(group_.get(), internal_.get(), even, sizeof(even), ctx_.get()) ||
+            !EC_POINT_mul(group_.get(), point_.get(), tweak_.get(), internal_.get(), one_.get(),
+                          ctx_.get()) ||
+            !EC_POINT_get_affine_coordinates(group_.get(), point_.get(), key_.get(), nullptr,
+                                             ctx_.get()) ||
+            BN_bn2binpad(key_.get(), out.data(), 32) != 32) {
+            throw std::runtime_error("Falha ao calcular a chave de saída P2TR");
+        }
+    }
+}
+
+bool CpuSearchEngine::seed_matches(const uint8_t* seed) {
+    static const char master_key[] = "Bitcoin seed";
+    uint8_t I[64];
+    unsigned int len = 64;
+
+    // Chave mestra, uma vez para todos os caminhos
+    HMAC(EVP_sha512(), master_key, 12, seed, 64, I, &len);
+    std::memcpy(keys_[0].data(), I, 32);
+    std::memcpy(chains_[0].data(), I + 32, 32);
+
+    // keys_[1..derived] valem para o prefixo do caminho anterior
+    const std::vector<uint32_t>* previous = nullptr;
+    size_t derived = 0;
+    uint8_t pub[33];
+    for (const auto& path : paths_) {
+        size_t depth = 0;
+        if (previous) {
+            while (depth < derived && depth < path.indices.size() &&
+                   (*previous)[depth] == path.indices[depth]) {
+                depth++;
+            }
+        }
+        for (; depth < path.indices.size(); depth++) {
+            derive_child(keys_[depth].data(), chains_[depth].data(), path.indices[depth],
+                         keys_[depth + 1].data(), chains_[depth + 1].data());
+        }
+        previous = &path.indices;
+        derived = path.indices.size();
+
+        if (gap_ == 0) {
+            if (key_matches(keys_[derived].data(), path.scripts)) {
+                return true;
+            }
+            continue;
+        }
+        // Janela: a chave pública de cada cadeia serve a todos os filhos
+        auto& chain_key = keys_[derived + 1];
+        auto& chain_code = chains_[derived + 1];
+        for (uint32_t change = 0; change < 2; change++) {
+            derive_child(keys_[derived].data(), chains_[derived].data(), change,
+                         chain_key.data(), chain_code.data());
+            public_key(chain_key.data(), pub);
+            for (uint32_t index = 0; index < gap_; index++) {
+                derive_child(chain_key.data(), chain_code.data(), index,
+                             keys_[derived + 2].data(), chains_[derived + 2].data(), pub);
+                if (key_matches(keys_[derived + 2].data(), path.scripts)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool CpuSearchEngine::key_matches(const uint8_t* key, uint32_t scripts) {
+    uint8_t pub[33];
+    public_key(key, pub);
+    for (uint32_t t = 0; t < Address::SCRIPT_TYPES; t++) {
+        const ScriptType script = static_cast<ScriptType>(t);
+        if (!(scripts & Address::bit(script))) {
+            continue;
+        }
+        script_program(script, pub, program_);
+        for (const auto& target : targets_) {
+            if (target.script == script && target.program == program_) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool CpuSearchEngine::checksum_ok(const uint32_t* phrase) const {
+    // 132 bits dos índices: 128 de entropia + 4 de checksum
+    uint8_t bytes[17] = {0};
+    uint32_t bit = 0;
+    for (uint32_t w = 0; w < space_.length(); w++) {
+        uint32_t index = bip39_index_[phrase[w]];
+        for (int b = 10; b >= 0; b--, bit++) {
+            if (index & (1u << b)) {
+                bytes[bit / 8] |= static_cast<uint8_t>(0x80 >> (bit % 8));
+            }
+        }
+    }
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    SHA256(bytes, 16, digest);
+    return (digest[0] >> 4) == (bytes[16] >> 4);
+}
+
+void CpuSearchEngine::search(const RankRange& batch, std::vector<uint64_t>& hits,
+                             std::vector<uint64_t>& samples, StageCounters* stages) {
+    hits.clear();
+    samples.clear();
+    if (batch.empty()) {
+        return;
+    }
+    StageCounters counted;
+    counted.enumerated = batch.size();
+
+    std::vector<uint32_t> indices = space_.unrank(batch.begin);
+
+    for (uint64_t rank = batch.begin; rank < batch.end;) {
+        // Frases do grupo pelo sucessor lexicográfico (mais barato que unrank).
+        // Frases com palavra repetida ou checksum inválido não passam pelo
+        // PBKDF2: o grupo junta GROUP_SIZE frases válidas, não ranks.
+        mnemonics_.clear();
+        ranks_.clear();
+        for (; rank < batch.end && mnemonics_.size() < GROUP_SIZE; rank++) {
+            bool valid = !space_.needs_distinct_check() || space_.distinct(indices.data());
+            if (valid && rank % SAMPLE_INTERVAL == 0) {
+                samples.push_back(rank);
+            }
+            counted.distinct += valid;
+            if (valid && (bip39_index_.empty() || checksum_ok(indices.data()))) {
+                std::string phrase;
+                for (size_t w = 0; w < indices.size(); w++) {
+                    if (w > 0) phrase += ' ';
+                    phrase += words_[indices[w]];
+                }
+                mnemonics_.push_back(std::move(phrase));
+                ranks_.push_back(rank);
+            }
+            space_.next(indices.data());
+        }
+        if (mnemonics_.empty()) {
+            continue;
+        }
+
+        Pbkdf2Lanes::derive(isa_, mnemonics_, seeds_);
+        counted.accepted += mnemonics_.size();
+        counted.seeds += mnemonics_.size();
+
+        for (size_t i = 0; i < mnemonics_.size(); i++) {
+            if (seed_matches(seeds_[i].data())) {
+                hits.push_back(ranks_[i]);
+            }
+        }
+    }
+
+    counted.keys = counted.seeds * keys_per_phrase_;
+    counted.hits = hits.size();
+    if (stages) {
+        *stages += counted;
+    }
+}
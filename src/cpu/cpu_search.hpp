@@ -0,0 +1,103 @@
+#pragma once
+#include "address.hpp"
+#include "cpu/pbkdf2_lanes.hpp"
+#include "job_spec.hpp"
+#include "search_space.hpp"
+#include "telemetry.hpp"
+#include "work_scheduler.hpp"
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Busca nativa na CPU com o mesmo espaço de frases e o mesmo pipeline do kernel
+// verify: rank -> frase -> checksum -> PBKDF2 (lanes SIMD) -> BIP32 (todos os
+// caminhos do job) -> scripts de cada chave -> comparação com os alvos.
+// Uma instância por thread.
+class CpuSearchEngine {
+public:
+    // Uma frase de amostra a cada SAMPLE_INTERVAL ranks (também nos lotes
+    // dos dispositivos OpenCL, escolhida pelo host)
+    static const uint64_t SAMPLE_INTERVAL = 200500000ULL;
+
+    // bip39_index: índice de cada palavra na wordlist BIP39; com ele, só
+    // frases de checksum válido passam pelo PBKDF2 (vazio = todas). gap > 0:
+    // caminhos de conta com janela de endereços (JobSpec::gap)
+    CpuSearchEngine(const SearchSpace& space,
+                    const std::vector<std::string>& words,
+                    const std::vector<uint16_t>& bip39_index,
+                    const std::vector<JobSpec::DerivationPath>& paths,
+                    const std::vector<std::string>& targets,
+                    uint32_t gap, SimdIsa isa);
+
+    CpuSearchEngine(const CpuSearchEngine&) = delete;
+    CpuSearchEngine& operator=(const CpuSearchEngine&) = delete;
+
+    // Testa os ranks de `batch`. Ranks que geram algum endereço alvo vão para
+    // `hits`; ranks de amostragem vão para `samples`. Com `stages`, soma lá
+    // as frases do lote em cada estágio (telemetria).
+    void search(const RankRange& batch, std::vector<uint64_t>& hits,
+                std::vector<uint64_t>& samples, StageCounters* stages = nullptr);
+
+    SimdIsa isa() const { return isa_; }
+
+private:
+    // Frases processadas por chamada do PBKDF2 (múltiplo de 8 lanes)
+    static const size_t GROUP_SIZE = 64;
+
+    // seed -> caminhos BIP32 -> scripts de cada chave, comparados com os
+    // alvos. Mesmo resultado de BitcoinUtils::derive_private_key +
+    // Address::program, mas com a chave mestra e os prefixos comuns dos
+    // caminhos derivados uma vez e o grupo secp256k1 e o BN_CTX reaproveitados.
+    bool seed_matches(const uint8_t* seed);
+    // CKDpriv: filho `index` de (key, chain); parent_pub evita recalcular a
+    // chave pública do pai nos índices normais
+    void derive_child(const uint8_t* key, const uint8_t* chain, uint32_t index,
+                      uint8_t* child_key, uint8_t* child_chain,
+                      const uint8_t* parent_pub = nullptr);
+    // Scripts de `scripts` da chave privada comparados com os alvos
+    bool key_matches(const uint8_t* key, uint32_t scripts);
+    // Valor comparado de `script` para a chave pública comprimida
+    void script_program(ScriptType script, const uint8_t* pub, std::vector<uint8_t>& out);
+    // Mesmo teste de job_checksum_ok (main.cl)
+    bool checksum_ok(const uint32_t* phrase) const;
+    void public_key(const uint8_t* private_key, uint8_t* out);
+
+    const SearchSpace& space_;
+    const std::vector<std::string>& words_;
+    std::vector<uint16_t> bip39_index_;
+    std::vector<JobSpec::DerivationPath> paths_;
+    std::vector<AddressTarget> targets_;
+    uint32_t gap_;
+    uint64_t keys_per_phrase_;   // chaves comparadas por frase
+    SimdIsa isa_;
+
+    template <class T, void (*Free)(T*)>
+    struct Deleter {
+        void operator()(T* p) const { Free(p); }
+    };
+    using Group = std::unique_ptr<EC_GROUP, Deleter<EC_GROUP, EC_GROUP_free>>;
+    using Point = std::unique_ptr<EC_POINT, Deleter<EC_POINT, EC_POINT_free>>;
+    using Ctx = std::unique_ptr<BN_CTX, Deleter<BN_CTX, BN_CTX_free>>;
+    using Num = std::unique_ptr<BIGNUM, Deleter<BIGNUM, BN_free>>;
+
+    Group group_;
+    Point point_;
+    Ctx ctx_;
+    Num order_;
+    Num key_;
+    Num tweak_;
+    Point internal_;   // chave interna do P2TR
+    Num one_;
+
+    // Chave e chain code por profundidade (0 = mestra) do caminho atual
+    std::vector<std::array<uint8_t, 32>> keys_, chains_;
+    std::vector<uint8_t> program_;
+
+    std::vector<std::string> mnemonics_;
+    std::vector<uint64_t> ranks_;        // rank de cada frase em mnemonics_
+    std::vector<std::array<uint8_t, 64>> seeds_;
+};
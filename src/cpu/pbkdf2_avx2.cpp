@@ -0,0 +1,39 @@
+// Compilado com -mavx2 (/arch:AVX2); usado só se a CPU suportar AVX2
+#include "cpu/pbkdf2_lanes.hpp"
+
+#ifdef FIND_SEED_X86
+#include <immintrin.h>
+#include "cpu/sha512_lanes.hpp"
+
+namespace {
+
+struct Avx2Ops {
+    typedef __m256i V;
+    static const size_t lanes = 4;
+
+    static inline V set1(uint64_t x) { return _mm256_set1_epi64x((long long)x); }
+    static inline V add(V a, V b) { return _mm256_add_epi64(a, b); }
+    static inline V xor_(V a, V b) { return _mm256_xor_si256(a, b); }
+    static inline V xor3(V a, V b, V c) { return _mm256_xor_si256(_mm256_xor_si256(a, b), c); }
+    static inline V ch(V e, V f, V g) {
+        return _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+    }
+    static inline V maj(V a, V b, V c) {
+        return _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    }
+    template <int N> static inline V rotr(V x) {
+        return _mm256_or_si256(_mm256_srli_epi64(x, N), _mm256_slli_epi64(x, 64 - N));
+    }
+    template <int N> static inline V shr(V x) { return _mm256_srli_epi64(x, N); }
+    static inline V load(const uint64_t* w) { return _mm256_loadu_si256((const __m256i*)w); }
+    static inline void store(V v, uint64_t* w) { _mm256_storeu_si256((__m256i*)w, v); }
+};
+
+} // namespace
+
+void bip39_pbkdf2_avx2(const uint8_t* const* keys, const size_t* key_lens,
+                       const uint8_t* salt, size_t salt_len, uint8_t (*out)[64]) {
+    Pbkdf2Lanes512<Avx2Ops>::derive(keys, key_lens, salt, salt_len, out);
+}
+
+#endif // FIND_SEED_X86
@@ -0,0 +1,34 @@
+// Compilado com -mavx512f (/arch:AVX512); usado só se a CPU suportar AVX-512F
+#include "cpu/pbkdf2_lanes.hpp"
+
+#ifdef FIND_SEED_X86
+#include <immintrin.h>
+#include "cpu/sha512_lanes.hpp"
+
+namespace {
+
+// vpternlogq: 0x96 = a^b^c, 0xCA = ch, 0xE8 = maj
+struct Avx512Ops {
+    typedef __m512i V;
+    static const size_t lanes = 8;
+
+    static inline V set1(uint64_t x) { return _mm512_set1_epi64((long long)x); }
+    static inline V add(V a, V b) { return _mm512_add_epi64(a, b); }
+    static inline V xor_(V a, V b) { return _mm512_xor_si512(a, b); }
+    static inline V xor3(V a, V b, V c) { return _mm512_ternarylogic_epi64(a, b, c, 0x96); }
+    static inline V ch(V e, V f, V g) { return _mm512_ternarylogic_epi64(e, f, g, 0xCA); }
+    static inline V maj(V a, V b, V c) { return _mm512_ternarylogic_epi64(a, b, c, 0xE8); }
+    template <int N> static inline V rotr(V x) { return _mm512_ror_epi64(x, N); }
+    template <int N> static inline V shr(V x) { return _mm512_srli_epi64(x, N); }
+    static inline V load(const uint64_t* w) { return _mm512_loadu_si512((const void*)w); }
+    static inline void store(V v, uint64_t* w) { _mm512_storeu_si512((void*)w, v); }
+};
+
+} // namespace
+
+void bip39_pbkdf2_avx512(const uint8_t* const* keys, const size_t* key_lens,
+                         const uint8_t* salt, size_t salt_len, uint8_t (*out)[64]) {
+    Pbkdf2Lanes512<Avx512Ops>::derive(keys, key_lens, salt, salt_len, out);
+}
+
+#endif // FIND_SEED_X86
@@ -0,0 +1,144 @@
+#include "cpu/pbkdf2_lanes.hpp"
+#include "cpu/sha512_lanes.hpp"
+#include <openssl/sha.h>
+#include <stdexcept>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef FIND_SEED_X86
+// Definidas em pbkdf2_avx2.cpp / pbkdf2_avx512.cpp (flags próprias)
+void bip39_pbkdf2_avx2(const uint8_t* const* keys, const size_t* key_lens,
+                       const uint8_t* salt, size_t salt_len, uint8_t (*out)[64]);
+void bip39_pbkdf2_avx512(const uint8_t* const* keys, const size_t* key_lens,
+                         const uint8_t* salt, size_t salt_len, uint8_t (*out)[64]);
+#endif
+
+namespace {
+
+struct ScalarOps {
+    typedef uint64_t V;
+    static const size_t lanes = 1;
+
+    static inline V set1(uint64_t x) { return x; }
+    static inline V add(V a, V b) { return a + b; }
+    static inline V xor_(V a, V b) { return a ^ b; }
+    static inline V xor3(V a, V b, V c) { return a ^ b ^ c; }
+    static inline V ch(V e, V f, V g) { return g ^ (e & (f ^ g)); }
+    static inline V maj(V a, V b, V c) { return (a & b) | (c & (a | b)); }
+    template <int N> static inline V rotr(V x) { return (x >> N) | (x << (64 - N)); }
+    template <int N> static inline V shr(V x) { return x >> N; }
+    static inline V load(const uint64_t* w) { return w[0]; }
+    static inline void store(V v, uint64_t* w) { w[0] = v; }
+};
+
+void bip39_pbkdf2_scalar(const uint8_t* const* keys, const size_t* key_lens,
+                         const uint8_t* salt, size_t salt_len, uint8_t (*out)[64]) {
+    Pbkdf2Lanes512<ScalarOps>::derive(keys, key_lens, salt, salt_len, out);
+}
+
+} // namespace
+
+SimdIsa Pbkdf2Lanes::detect() {
+#if defined(FIND_SEED_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdIsa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdIsa::AVX2;
+    }
+#elif defined(FIND_SEED_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (osxsave && max_leaf >= 7) {
+        // O sistema precisa salvar os registradores YMM/ZMM
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        if ((xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16))) {
+            return SimdIsa::AVX512;
+        }
+        if ((xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5))) {
+            return SimdIsa::AVX2;
+        }
+    }
+#endif
+    return SimdIsa::Scalar;
+}
+
+const char* Pbkdf2Lanes::name(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::AVX512: return "AVX-512";
+        case SimdIsa::AVX2: return "AVX2";
+        default: return "escalar";
+    }
+}
+
+size_t Pbkdf2Lanes::lanes(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::AVX512: return 8;
+        case SimdIsa::AVX2: return 4;
+        default: return 1;
+    }
+}
+
+void Pbkdf2Lanes::derive(SimdIsa isa, const std::vector<std::string>& mnemonics,
+                         std::vector<std::array<uint8_t, 64>>& seeds,
+                         const std::string& passphrase) {
+    // salt, INT(1) e o 0x80 do padding precisam caber nas palavras 0 a 13 do
+    // bloco (112 bytes): a 14 e a 15 são o comprimento de 128 bits
+    std::string salt = "mnemonic" + passphrase;
+    if (salt.size() > 107) {
+        throw std::invalid_argument("Passphrase longa demais para o motor de CPU");
+    }
+
+    auto kernel = bip39_pbkdf2_scalar;
+#ifdef FIND_SEED_X86
+    if (isa == SimdIsa::AVX512) {
+        kernel = bip39_pbkdf2_avx512;
+    } else if (isa == SimdIsa::AVX2) {
+        kernel = bip39_pbkdf2_avx2;
+    }
+#endif
+    const size_t width = lanes(isa);
+
+    seeds.resize(mnemonics.size());
+
+    // HMAC: chaves maiores que o bloco (128 bytes) são substituídas pelo SHA-512
+    std::vector<std::array<uint8_t, 64>> hashed_keys(mnemonics.size());
+    std::vector<const uint8_t*> keys(mnemonics.size());
+    std::vector<size_t> key_lens(mnemonics.size());
+    for (size_t i = 0; i < mnemonics.size(); i++) {
+        const auto* data = reinterpret_cast<const uint8_t*>(mnemonics[i].data());
+        if (mnemonics[i].size() > 128) {
+            SHA512(data, mnemonics[i].size(), hashed_keys[i].data());
+            keys[i] = hashed_keys[i].data();
+            key_lens[i] = 64;
+        } else {
+            keys[i] = data;
+            key_lens[i] = mnemonics[i].size();
+        }
+    }
+
+    // Grupos de `width` frases; o último grupo repete a última frase
+    const uint8_t* group_keys[8];
+    size_t group_lens[8];
+    uint8_t group_out[8][64];
+    for (size_t first = 0; first < mnemonics.size(); first += width) {
+        for (size_t l = 0; l < width; l++) {
+            size_t index = (first + l < mnemonics.size()) ? first + l : mnemonics.size() - 1;
+            group_keys[l] = keys[index];
+            group_lens[l] = key_lens[index];
+        }
+
+        kernel(group_keys, group_lens, reinterpret_cast<const uint8_t*>(salt.data()),
+               salt.size(), group_out);
+
+        for (size_t l = 0; l < width && first + l < mnemonics.size(); l++) {
+            std::copy(group_out[l], group_out[l] + 64, seeds[first + l].begin());
+        }
+    }
+}
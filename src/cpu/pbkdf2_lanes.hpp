@@ -0,0 +1,34 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FIND_SEED_X86 1
+#endif
+
+// Conjunto de instruções usado pelo motor nativo de CPU
+enum class SimdIsa {
+    Scalar,   // 1 lane (uint64_t)
+    AVX2,     // 4 lanes (__m256i)
+    AVX512    // 8 lanes (__m512i, rotações nativas de 64 bits)
+};
+
+// PBKDF2-HMAC-SHA512 do BIP39 com várias frases em paralelo nos lanes SIMD.
+// O conjunto de instruções é escolhido em tempo de execução.
+class Pbkdf2Lanes {
+public:
+    // Melhor conjunto suportado pela CPU e pelo sistema operacional
+    static SimdIsa detect();
+
+    static const char* name(SimdIsa isa);
+    static size_t lanes(SimdIsa isa);
+
+    // Seed BIP39 de cada frase (salt "mnemonic" + passphrase, 2048 iterações).
+    // Lança std::invalid_argument para passphrase de mais de 99 bytes.
+    static void derive(SimdIsa isa, const std::vector<std::string>& mnemonics,
+                       std::vector<std::array<uint8_t, 64>>& seeds,
+                       const std::string& passphrase = "");
+};
@@ -0,0 +1,218 @@
+#pragma once
+// PBKDF2-HMAC-SHA512 do BIP39 em L cadeias independentes, uma por lane.
+// `Ops` define o tipo vetorial e as operações de 64 bits (ver
+// pbkdf2_lanes.cpp, pbkdf2_avx2.cpp e pbkdf2_avx512.cpp).
+//
+// Incluído apenas pelos arquivos de cada conjunto de instruções, que são
+// compilados com flags diferentes (-mavx2, -mavx512f). Tudo fica em namespace
+// anônimo e sem templates da biblioteca padrão para que nenhuma função
+// compilada com AVX seja compartilhada pelo linker com o resto do programa.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+const uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+const uint64_t SHA512_IV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+template <class Ops>
+struct Pbkdf2Lanes512 {
+    typedef typename Ops::V V;
+    static const size_t L = Ops::lanes;
+
+    static inline V Sigma0(V a) {
+        return Ops::xor3(Ops::template rotr<28>(a), Ops::template rotr<34>(a), Ops::template rotr<39>(a));
+    }
+    static inline V Sigma1(V e) {
+        return Ops::xor3(Ops::template rotr<14>(e), Ops::template rotr<18>(e), Ops::template rotr<41>(e));
+    }
+    static inline V sigma0(V w) {
+        return Ops::xor3(Ops::template rotr<1>(w), Ops::template rotr<8>(w), Ops::template shr<7>(w));
+    }
+    static inline V sigma1(V w) {
+        return Ops::xor3(Ops::template rotr<19>(w), Ops::template rotr<61>(w), Ops::template shr<6>(w));
+    }
+
+#define LANES_ROUND(a, b, c, d, e, f, g, h, i)                                  \
+    do {                                                                        \
+        if ((i) >= 16) {                                                        \
+            w[(i) & 15] = Ops::add(Ops::add(w[(i) & 15], sigma0(w[((i) + 1) & 15])), \
+                                   Ops::add(w[((i) + 9) & 15], sigma1(w[((i) + 14) & 15]))); \
+        }                                                                       \
+        V t1 = Ops::add(Ops::add(h, Sigma1(e)),                                 \
+                        Ops::add(Ops::ch(e, f, g),                              \
+                                 Ops::add(Ops::set1(SHA512_K[i]), w[(i) & 15]))); \
+        d = Ops::add(d, t1);                                                    \
+        h = Ops::add(t1, Ops::add(Sigma0(a), Ops::maj(a, b, c)));               \
+    } while (0)
+
+    static void compress(V* state, const V* block) {
+        V w[16];
+        for (int i = 0; i < 16; i++) {
+            w[i] = block[i];
+        }
+
+        V a = state[0], b = state[1], c = state[2], d = state[3];
+        V e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 80; i += 8) {
+            LANES_ROUND(a, b, c, d, e, f, g, h, i + 0);
+            LANES_ROUND(h, a, b, c, d, e, f, g, i + 1);
+            LANES_ROUND(g, h, a, b, c, d, e, f, i + 2);
+            LANES_ROUND(f, g, h, a, b, c, d, e, i + 3);
+            LANES_ROUND(e, f, g, h, a, b, c, d, i + 4);
+            LANES_ROUND(d, e, f, g, h, a, b, c, i + 5);
+            LANES_ROUND(c, d, e, f, g, h, a, b, i + 6);
+            LANES_ROUND(b, c, d, e, f, g, h, a, i + 7);
+        }
+
+        state[0] = Ops::add(state[0], a);
+        state[1] = Ops::add(state[1], b);
+        state[2] = Ops::add(state[2], c);
+        state[3] = Ops::add(state[3], d);
+        state[4] = Ops::add(state[4], e);
+        state[5] = Ops::add(state[5], f);
+        state[6] = Ops::add(state[6], g);
+        state[7] = Ops::add(state[7], h);
+    }
+
+#undef LANES_ROUND
+
+    // Palavra big-endian `index` de uma mensagem, com zeros além do fim
+    static uint64_t be_word(const uint8_t* data, size_t len, size_t index, uint8_t pad) {
+        uint64_t word = 0;
+        for (size_t j = 0; j < 8; j++) {
+            size_t pos = index * 8 + j;
+            uint8_t byte = (pos < len) ? data[pos] : 0;
+            word = (word << 8) | (uint8_t)(byte ^ pad);
+        }
+        return word;
+    }
+
+    static V iv(int i) {
+        return Ops::set1(SHA512_IV[i]);
+    }
+
+    // Bloco de 64 bytes (digest) + padding fixo de uma mensagem de 192 bytes
+    static void digest_block(const V* digest, V* block) {
+        for (int i = 0; i < 8; i++) {
+            block[i] = digest[i];
+        }
+        block[8] = Ops::set1(0x8000000000000000ULL);
+        for (int i = 9; i < 15; i++) {
+            block[i] = Ops::set1(0);
+        }
+        block[15] = Ops::set1(1536);  // (128 + 64) * 8
+    }
+
+    // keys: L chaves (no máximo 128 bytes); salt: até 107 bytes (com INT(1)
+    // e o padding antes do comprimento), igual em todos os lanes; out: L
+    // seeds de 64 bytes
+    static void derive(const uint8_t* const* keys, const size_t* key_lens,
+                       const uint8_t* salt, size_t salt_len, uint8_t (*out)[64]) {
+        uint64_t lane_words[L];
+
+        // Estados intermediários de ipad e opad (calculados uma vez)
+        V block[16];
+        V inner[8], outer[8];
+        for (int i = 0; i < 8; i++) {
+            inner[i] = iv(i);
+            outer[i] = iv(i);
+        }
+        for (size_t w = 0; w < 16; w++) {
+            for (size_t l = 0; l < L; l++) {
+                lane_words[l] = be_word(keys[l], key_lens[l], w, 0x36);
+            }
+            block[w] = Ops::load(lane_words);
+        }
+        compress(inner, block);
+        for (size_t w = 0; w < 16; w++) {
+            for (size_t l = 0; l < L; l++) {
+                lane_words[l] = be_word(keys[l], key_lens[l], w, 0x5c);
+            }
+            block[w] = Ops::load(lane_words);
+        }
+        compress(outer, block);
+
+        // U1 = HMAC(salt || INT(1))
+        uint8_t first[128] = {0};
+        for (size_t i = 0; i < salt_len; i++) {
+            first[i] = salt[i];
+        }
+        first[salt_len + 3] = 1;
+        first[salt_len + 4] = 0x80;
+        for (size_t w = 0; w < 15; w++) {
+            block[w] = Ops::set1(be_word(first, 128, w, 0));
+        }
+        block[15] = Ops::set1((128 + salt_len + 4) * 8);
+
+        V u[8], t[8];
+        for (int i = 0; i < 8; i++) {
+            u[i] = inner[i];
+        }
+        compress(u, block);
+        digest_block(u, block);
+        for (int i = 0; i < 8; i++) {
+            u[i] = outer[i];
+        }
+        compress(u, block);
+        for (int i = 0; i < 8; i++) {
+            t[i] = u[i];
+        }
+
+        // U2..U2048; só as 8 primeiras palavras do bloco mudam
+        digest_block(u, block);
+        for (int iter = 1; iter < 2048; iter++) {
+            for (int i = 0; i < 8; i++) {
+                u[i] = inner[i];
+            }
+            compress(u, block);
+            for (int i = 0; i < 8; i++) {
+                block[i] = u[i];
+                u[i] = outer[i];
+            }
+            compress(u, block);
+            for (int i = 0; i < 8; i++) {
+                block[i] = u[i];
+                t[i] = Ops::xor_(t[i], u[i]);
+            }
+        }
+
+        for (int i = 0; i < 8; i++) {
+            Ops::store(t[i], lane_words);
+            for (size_t l = 0; l < L; l++) {
+                for (int j = 0; j < 8; j++) {
+                    out[l][i * 8 + j] = (uint8_t)(lane_words[l] >> (56 - 8 * j));
+                }
+            }
+        }
+    }
+};
+
+} // namespace
@@ -0,0 +1,300 @@
+#include "dispatch_engine.hpp"
+#include "globals.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// status[STATUS_COUNT], status[STATUS_HITS] e os contadores por estágio
+// STATUS_DISTINCT a STATUS_KEYS (bip39.cl)
+enum StatusWord { STATUS_COUNT, STATUS_HITS, STATUS_DISTINCT, STATUS_ACCEPTED, STATUS_SEEDS,
+                  STATUS_KEYS, STATUS_WORDS };
+const size_t STATUS_BYTES = sizeof(cl_uint) * STATUS_WORDS;
+const size_t HITS_BYTES = sizeof(cl_ulong) * DispatchEngine::HIT_QUEUE_SIZE;
+const size_t STAGING_BYTES = STATUS_BYTES + HITS_BYTES;
+
+} // namespace
+
+DispatchEngine::DispatchEngine(OpenCLManager& manager, cl::Kernel& filter,
+                               cl::Kernel& verify, size_t local_size,
+                               uint64_t max_batch, size_t depth)
+    : manager_(manager), filter_(&filter), verify_(&verify), local_size_(local_size),
+      max_batch_(max_batch), slots_(depth) {
+    if (depth == 0 || local_size == 0) {
+        throw std::invalid_argument("Profundidade ou grupo local inválido");
+    }
+    // Candidatos são deslocamentos de 32 bits dentro do lote
+    if (max_batch == 0 || max_batch > UINT32_MAX) {
+        throw std::invalid_argument("Tamanho máximo de lote inválido");
+    }
+    create_slots(max_batch);
+}
+
+DispatchEngine::DispatchEngine(OpenCLManager& manager, cl::Kernel& persistent,
+                               size_t local_size, size_t groups, size_t depth)
+    : manager_(manager), persistent_(&persistent), local_size_(local_size),
+      groups_(groups), slots_(depth) {
+    if (depth == 0 || local_size == 0 || groups == 0) {
+        throw std::invalid_argument("Profundidade, grupo local ou grade inválidos");
+    }
+    if (local_size > PERSISTENT_MAX_LOCAL) {
+        throw std::invalid_argument("Grupo local maior que a fila do kernel persistente");
+    }
+    // next_block é um contador de 32 bits de blocos de local_size ranks
+    max_batch_ = static_cast<uint64_t>(UINT32_MAX) * local_size;
+
+    // Flag de parada visível ao kernel em execução: só com SVM de
+    // granularidade fina; sem ela os lotes persistentes vão até o fim
+    cl_device_svm_capabilities svm = manager_.device.getInfo<CL_DEVICE_SVM_CAPABILITIES>();
+    if (svm & CL_DEVICE_SVM_FINE_GRAIN_BUFFER) {
+        stop_svm_ = static_cast<cl_uint*>(clSVMAlloc(
+            manager_.context(), CL_MEM_READ_WRITE | CL_MEM_SVM_FINE_GRAIN_BUFFER,
+            sizeof(cl_uint), 0));
+    }
+    if (stop_svm_) {
+        *stop_svm_ = 0;
+    } else {
+        cl_uint zero = 0;
+        stop_buffer_ = cl::Buffer(manager_.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                  sizeof(cl_uint), &zero);
+    }
+    create_slots(0);
+}
+
+void DispatchEngine::create_slots(uint64_t candidates) {
+    for (auto& slot : slots_) {
+        slot.status = cl::Buffer(manager_.context, CL_MEM_READ_WRITE, STATUS_BYTES);
+        slot.hits = cl::Buffer(manager_.context, CL_MEM_WRITE_ONLY, HITS_BYTES);
+        if (candidates > 0) {
+            slot.candidates = cl::Buffer(manager_.context, CL_MEM_READ_WRITE,
+                                         sizeof(cl_uint) * candidates);
+        }
+
+        // Memória fixada: leituras assíncronas vão direto por DMA para cá
+        slot.staging = cl::Buffer(manager_.context,
+                                  CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR,
+                                  STAGING_BYTES);
+        slot.host = static_cast<unsigned char*>(manager_.queue.enqueueMapBuffer(
+            slot.staging, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, STAGING_BYTES));
+    }
+}
+
+DispatchEngine::~DispatchEngine() {
+    // Não lançar exceções no destrutor; em erro o contexto é descartado mesmo
+    try {
+        if (stop_svm_) {
+            *stop_svm_ = 1;
+        }
+        manager_.queue.finish();
+        for (auto& slot : slots_) {
+            if (slot.host) {
+                manager_.queue.enqueueUnmapMemObject(slot.staging, slot.host);
+            }
+        }
+        manager_.queue.finish();
+        if (stop_svm_) {
+            clSVMFree(manager_.context(), const_cast<cl_uint*>(stop_svm_));
+        }
+    } catch (...) {
+    }
+}
+
+void DispatchEngine::launch(Slot& slot, const RankRange& batch) {
+    cl::CommandQueue& queue = manager_.queue;
+    if (batch.size() > max_batch_) {
+        throw std::invalid_argument("Lote maior que o máximo do DispatchEngine");
+    }
+
+    // Zerar os contadores do slot no próprio device (sem escrita do host); a
+    // fila de acertos não precisa: só as posições contadas são lidas
+    std::vector<cl::Event> cleared(1);
+    queue.enqueueFillBuffer(slot.status, static_cast<cl_uint>(0), 0, STATUS_BYTES,
+                            nullptr, &cleared[0]);
+
+    if (persistent_) {
+        launch_persistent(slot, batch, cleared);
+        return;
+    }
+
+    // Arredondar para cima; o filter descarta ranks >= fim do lote
+    size_t global_size = ((batch.size() + local_size_ - 1) / local_size_) * local_size_;
+
+    filter_->setArg(0, slot.candidates);
+    filter_->setArg(1, slot.status);
+    filter_->setArg(2, static_cast<cl_ulong>(batch.begin));
+    filter_->setArg(3, static_cast<cl_ulong>(batch.end));
+
+    std::vector<cl::Event> filtered(1);
+    queue.enqueueNDRangeKernel(*filter_, cl::NullRange, cl::NDRange(global_size),
+                               cl::NDRange(local_size_), &cleared, &filtered[0]);
+
+    // O contador só é conhecido no device: verify é lançado com o lote todo
+    // e os work-items além do contador saem sem trabalho. Os candidatos
+    // ficam nos primeiros work-items, então os grupos ativos estão cheios.
+    verify_->setArg(0, slot.status);
+    verify_->setArg(1, slot.hits);
+    verify_->setArg(2, slot.candidates);
+    verify_->setArg(3, static_cast<cl_ulong>(batch.begin));
+
+    std::vector<cl::Event> executed(1);
+    queue.enqueueNDRangeKernel(*verify_, cl::NullRange, cl::NDRange(global_size),
+                               cl::NDRange(local_size_), &filtered, &executed[0]);
+
+    // Só os contadores (acertos e estágios), numa leitura não bloqueante
+    // para a área pinned
+    slot.started = filtered[0];
+    slot.finished = executed[0];
+    slot.reads.assign(1, cl::Event());
+    queue.enqueueReadBuffer(slot.status, CL_FALSE, 0, STATUS_BYTES,
+                            slot.host, &executed, &slot.reads[0]);
+    queue.flush();
+
+    slot.batch = batch;
+    slot.busy = true;
+}
+
+void DispatchEngine::launch_persistent(Slot& slot, const RankRange& batch,
+                                       const std::vector<cl::Event>& cleared) {
+    cl::CommandQueue& queue = manager_.queue;
+
+    persistent_->setArg(0, slot.status);
+    persistent_->setArg(1, slot.hits);
+    if (stop_svm_) {
+        cl_int err = clSetKernelArgSVMPointer((*persistent_)(), 2,
+                                              const_cast<cl_uint*>(stop_svm_));
+        if (err != CL_SUCCESS) {
+            throw cl::Error(err, "clSetKernelArgSVMPointer");
+        }
+    } else {
+        persistent_->setArg(2, stop_buffer_);
+    }
+    persistent_->setArg(3, static_cast<cl_ulong>(batch.begin));
+    persistent_->setArg(4, static_cast<cl_ulong>(batch.end));
+
+    // Grade fixa: o tamanho do lote não muda o lançamento
+    std::vector<cl::Event> executed(1);
+    queue.enqueueNDRangeKernel(*persistent_, cl::NullRange,
+                               cl::NDRange(groups_ * local_size_),
+                               cl::NDRange(local_size_), &cleared, &executed[0]);
+
+    // Blocos pegos (para saber até onde foi), acertos e estágios numa leitura só
+    slot.started = executed[0];
+    slot.finished = executed[0];
+    slot.reads.assign(1, cl::Event());
+    queue.enqueueReadBuffer(slot.status, CL_FALSE, 0, STATUS_BYTES,
+                            slot.host, &executed, &slot.reads[0]);
+    queue.flush();
+
+    slot.batch = batch;
+    slot.busy = true;
+}
+
+void DispatchEngine::wait(Slot& slot) {
+    // Com a flag de parada, acompanhar should_exit enquanto o lote roda:
+    // Ctrl-C interrompe um lote persistente em vez de esperar o fim dele
+    if (stop_svm_) {
+        while (slot.reads.back().getInfo<CL_EVENT_COMMAND_EXECUTION_STATUS>() > CL_COMPLETE) {
+            if (should_exit) {
+                *stop_svm_ = 1;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    cl::Event::waitForEvents(slot.reads);
+}
+
+BatchResult DispatchEngine::collect(Slot& slot) {
+    wait(slot);
+
+    cl_uint status[STATUS_WORDS];
+    std::memcpy(status, slot.host, STATUS_BYTES);
+
+    BatchResult out;
+    out.batch = slot.batch;
+    if (persistent_) {
+        // Todo bloco pego foi processado; blocos além do fim não existem
+        uint64_t covered = std::min<uint64_t>(slot.batch.size(),
+                                              static_cast<uint64_t>(status[STATUS_COUNT]) *
+                                                  local_size_);
+        out.batch.end = slot.batch.begin + covered;
+        out.remainder = {out.batch.end, slot.batch.end};
+    }
+
+    // Fila de acertos só quando há algum. A leitura é bloqueante e espera
+    // também os lotes enfileirados depois deste, mas acerto é raro.
+    out.hit_count = status[STATUS_HITS];
+    if (out.hit_count > 0) {
+        const size_t queued = std::min<size_t>(out.hit_count, HIT_QUEUE_SIZE);
+        manager_.queue.enqueueReadBuffer(slot.hits, CL_TRUE, 0, sizeof(cl_ulong) * queued,
+                                         slot.host + STATUS_BYTES);
+        out.hits.resize(queued);
+        std::memcpy(out.hits.data(), slot.host + STATUS_BYTES, sizeof(cl_ulong) * queued);
+    }
+
+    out.stages.enumerated = out.batch.size();
+    out.stages.distinct = status[STATUS_DISTINCT];
+    out.stages.accepted = status[STATUS_ACCEPTED];
+    out.stages.seeds = status[STATUS_SEEDS];
+    out.stages.keys = status[STATUS_KEYS];
+    out.stages.hits = out.hit_count;
+
+    // Tempo só de kernel: o lote seguinte já pode estar enfileirado, então
+    // o intervalo entre conclusões não serve para dimensionar lotes
+    try {
+        cl_ulong start = slot.started.getProfilingInfo<CL_PROFILING_COMMAND_START>();
+        cl_ulong end = slot.finished.getProfilingInfo<CL_PROFILING_COMMAND_END>();
+        out.kernel_seconds = end > start ? static_cast<double>(end - start) * 1e-9 : 0.0;
+    } catch (const cl::Error&) {
+    }
+
+    slot.busy = false;
+    return out;
+}
+
+void DispatchEngine::run(const NextBatch& next, const OnComplete& on_complete) {
+    bool more = true;
+
+    // Encher o pipeline
+    for (auto& slot : slots_) {
+        RankRange batch;
+        if (should_exit || !next(batch)) {
+            more = false;
+            break;
+        }
+        launch(slot, batch);
+    }
+
+    // A fila é em ordem: os slots terminam na ordem em que foram lançados
+    auto last = std::chrono::steady_clock::now();
+    for (size_t i = 0; slots_[i].busy; i = (i + 1) % slots_.size()) {
+        Slot& slot = slots_[i];
+        BatchResult result = collect(slot);
+
+        auto now = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed = now - last;
+        last = now;
+
+        // Relançar antes de entregar o resultado ao host
+        RankRange batch;
+        if (more && !should_exit && next(batch)) {
+            launch(slot, batch);
+        } else {
+            more = false;
+        }
+
+        on_complete(result, elapsed.count());
+    }
+}
+
+std::vector<RankRange> DispatchEngine::in_flight() const {
+    std::vector<RankRange> pending;
+    for (const auto& slot : slots_) {
+        if (slot.busy) {
+            pending.push_back(slot.batch);
+        }
+    }
+    return pending;
+}
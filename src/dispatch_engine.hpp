@@ -0,0 +1,108 @@
+#pragma once
+#include "opencl_manager.hpp"
+#include "telemetry.hpp"
+#include "work_scheduler.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Resultado de um lote lido do dispositivo
+struct BatchResult {
+    RankRange batch;              // ranks testados
+    RankRange remainder;          // parte do lote não testada (modo persistente parado)
+    std::vector<uint64_t> hits;   // ranks que bateram com algum alvo (a confirmar)
+    uint32_t hit_count = 0;       // acertos no device, inclusive os que não couberam na fila
+    StageCounters stages;         // frases de `batch` em cada estágio
+    double kernel_seconds = 0.0;  // do início do primeiro kernel ao fim do último
+                                  // (profiling; 0 se a fila não tem profiling)
+};
+
+// Mantém vários lotes em voo num dispositivo. Cada slot tem seus próprios
+// buffers de resultado e uma área de staging em memória fixada (pinned) no
+// host; zerar resultado -> kernels -> leitura não bloqueante são encadeados
+// por eventos. O host só espera pelo lote mais antigo, e o slot é relançado
+// antes do resultado ser entregue, então a GPU nunca fica ociosa esperando o
+// host.
+//
+// Dois modos:
+//   - compactado: filter + verify, um work-item por rank do lote;
+//   - persistente: search_persistent com a grade do tamanho da ocupação do
+//     device; os grupos pegam blocos de ranks de um contador atômico até o
+//     fim do lote, então um lançamento cobre lotes muito maiores.
+class DispatchEngine {
+public:
+    using NextBatch = std::function<bool(RankRange&)>;
+    using OnComplete = std::function<void(const BatchResult&, double seconds)>;
+
+    // Maior grupo local do modo persistente (PERSISTENT_MAX_LOCAL em bip39.cl)
+    static const size_t PERSISTENT_MAX_LOCAL = 256;
+    // Posições da fila de acertos de cada lote (HIT_QUEUE_SIZE em bip39.cl)
+    static const size_t HIT_QUEUE_SIZE = 64;
+
+    // filter(candidates, status, rank_offset, rank_end) compacta as frases
+    // que passam no checksum; verify(status, hits, candidates, rank_offset,
+    // ec_table, dictionary) roda o PBKDF2 só nelas. Alvos e caminhos são
+    // constantes do programa (JobSpec::kernel_header); ec_table e
+    // dictionary (os últimos argumentos) são definidos por quem cria o
+    // kernel. max_batch limita o tamanho dos lotes pedidos em run().
+    DispatchEngine(OpenCLManager& manager, cl::Kernel& filter, cl::Kernel& verify,
+                   size_t local_size, uint64_t max_batch, size_t depth = 3);
+
+    // search_persistent(status, hits, stop, rank_begin, rank_end, ec_table,
+    // dictionary) com `groups` grupos de local_size work-items. Se o device
+    // tem SVM de granularidade fina, `stop` fica em memória compartilhada e
+    // should_exit interrompe os lotes em voo; senão eles vão até o fim.
+    DispatchEngine(OpenCLManager& manager, cl::Kernel& persistent,
+                   size_t local_size, size_t groups, size_t depth = 2);
+    ~DispatchEngine();
+
+    DispatchEngine(const DispatchEngine&) = delete;
+    DispatchEngine& operator=(const DispatchEngine&) = delete;
+
+    // Lança lotes enquanto next() fornecer trabalho e should_exit for falso,
+    // depois drena os que estão em voo. on_complete recebe os lotes na ordem
+    // de lançamento e o intervalo desde a conclusão anterior. O tamanho de
+    // cada lote é de next(); BatchSizer o escolhe pelo kernel_seconds.
+    void run(const NextBatch& next, const OnComplete& on_complete);
+
+    // Lotes lançados e não concluídos (para devolver ao escalonador em erro)
+    std::vector<RankRange> in_flight() const;
+
+    bool persistent() const { return persistent_ != nullptr; }
+    // Lotes persistentes podem ser interrompidos pelo host
+    bool has_stop_flag() const { return stop_svm_ != nullptr; }
+
+private:
+    struct Slot {
+        cl::Buffer status;        // candidatos (ou blocos pegos), acertos e estágios
+        cl::Buffer hits;          // HIT_QUEUE_SIZE ranks, lidos só se houver acerto
+        cl::Buffer candidates;    // até max_batch deslocamentos aprovados pelo filter
+        cl::Buffer staging;       // CL_MEM_ALLOC_HOST_PTR, mapeado em host
+        unsigned char* host = nullptr;
+        std::vector<cl::Event> reads;
+        cl::Event started, finished;  // primeiro e último kernel do lote
+        RankRange batch;
+        bool busy = false;
+    };
+
+    void create_slots(uint64_t candidates);
+    void launch(Slot& slot, const RankRange& batch);
+    void launch_persistent(Slot& slot, const RankRange& batch,
+                           const std::vector<cl::Event>& cleared);
+    void wait(Slot& slot);
+    BatchResult collect(Slot& slot);
+
+    OpenCLManager& manager_;
+    cl::Kernel* filter_ = nullptr;
+    cl::Kernel* verify_ = nullptr;
+    cl::Kernel* persistent_ = nullptr;
+    size_t local_size_;
+    size_t groups_ = 0;
+    uint64_t max_batch_ = 0;
+    std::vector<Slot> slots_;
+
+    // Flag de parada do modo persistente: SVM fina (o kernel vê a escrita do
+    // host durante a execução) ou um buffer sempre zero
+    volatile cl_uint* stop_svm_ = nullptr;
+    cl::Buffer stop_buffer_;
+};
@@ -0,0 +1,70 @@
+#include "ec_table.hpp"
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+template <class T, void (*Free)(T*)>
+struct Deleter {
+    void operator()(T* p) const { Free(p); }
+};
+using Group = std::unique_ptr<EC_GROUP, Deleter<EC_GROUP, EC_GROUP_free>>;
+using Point = std::unique_ptr<EC_POINT, Deleter<EC_POINT, EC_POINT_free>>;
+using Ctx = std::unique_ptr<BN_CTX, Deleter<BN_CTX, BN_CTX_free>>;
+using Num = std::unique_ptr<BIGNUM, Deleter<BIGNUM, BN_free>>;
+
+void check(int ok, const char* what) {
+    if (!ok) {
+        throw std::runtime_error(std::string("Falha ao gerar a tabela de G: ") + what);
+    }
+}
+
+// 32 bytes big-endian -> 8 limbs little-endian (formato de ec.cl)
+void store_limbs(const BIGNUM* value, uint32_t* out) {
+    unsigned char bytes[32];
+    check(BN_bn2binpad(value, bytes, sizeof(bytes)) == 32, "BN_bn2binpad");
+    for (int i = 0; i < 8; i++) {
+        const unsigned char* b = bytes + 28 - 4 * i;
+        out[i] = (uint32_t(b[0]) << 24) | (uint32_t(b[1]) << 16) | (uint32_t(b[2]) << 8) | b[3];
+    }
+}
+
+}  // namespace
+
+const std::vector<uint32_t>& EcTable::generator() {
+    static const std::vector<uint32_t> table = build();
+    return table;
+}
+
+std::vector<uint32_t> EcTable::build() {
+    Group group(EC_GROUP_new_by_curve_name(NID_secp256k1));
+    Ctx ctx(BN_CTX_new());
+    check(group && ctx, "EC_GROUP_new_by_curve_name");
+
+    std::vector<uint32_t> table(WINDOWS * ENTRIES * ENTRY_UINTS);
+    Point base(EC_POINT_dup(EC_GROUP_get0_generator(group.get()), group.get()));
+    Point point(EC_POINT_new(group.get()));
+    Num x(BN_new()), y(BN_new());
+    check(base && point && x && y, "EC_POINT_new");
+
+    for (size_t j = 0; j < WINDOWS; j++) {
+        // base = 2^(8j) * G; point percorre v * base
+        check(EC_POINT_copy(point.get(), base.get()), "EC_POINT_copy");
+        for (size_t v = 1; v <= ENTRIES; v++) {
+            check(EC_POINT_get_affine_coordinates(group.get(), point.get(), x.get(), y.get(),
+                                                  ctx.get()),
+                  "EC_POINT_get_affine_coordinates");
+            uint32_t* entry = table.data() + (j * ENTRIES + v - 1) * ENTRY_UINTS;
+            store_limbs(x.get(), entry);
+            store_limbs(y.get(), entry + 8);
+            check(EC_POINT_add(group.get(), point.get(), point.get(), base.get(), ctx.get()),
+                  "EC_POINT_add");
+        }
+        // point = 256 * base
+        check(EC_POINT_copy(base.get(), point.get()), "EC_POINT_copy");
+    }
+    return table;
+}
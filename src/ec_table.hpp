@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Tabela fixa de G para o kernel (EC_FIXED_BASE em ec.cl): para cada byte j
+// da chave privada e cada valor v de 1 a 255, o ponto afim v * 2^(8j) * G,
+// em 8 limbs little-endian de x seguidos de 8 de y. Com ela k * G é a soma
+// de até 32 entradas, sem dobramentos.
+class EcTable {
+public:
+    static const size_t WINDOWS = 32;       // EC_TABLE_WINDOWS
+    static const size_t ENTRIES = 255;      // EC_TABLE_ENTRIES
+    static const size_t ENTRY_UINTS = 16;
+
+    static size_t bytes() { return WINDOWS * ENTRIES * ENTRY_UINTS * sizeof(uint32_t); }
+
+    // Calculada com OpenSSL na primeira chamada e reaproveitada
+    static const std::vector<uint32_t>& generator();
+
+private:
+    static std::vector<uint32_t> build();
+};
@@ -16,8 +16,13 @@ const std::vector<std::string> FIXED_WORDS = {
 
 const std::string TARGET_ADDRESS = "1EciYvS7FFjSYfrWxsWYjGB8K9BobBfCXw"; 
 
-bool found_address = false;
-bool should_exit = false;
+// m/44'/0'/0'/0/0
+const std::vector<uint32_t> DERIVATION_PATH = {
+    0x8000002C, 0x80000000, 0x80000000, 0, 0
+};
+
+std::atomic<bool> found_address{false};
+std::atomic<bool> should_exit{false};
 uint64_t current_low = 0;
 uint64_t current_high = 0; 
 
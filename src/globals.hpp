@@ -1,6 +1,8 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <atomic>
 
 // Lista de palavras pré-configuradas para busca
 extern const std::vector<std::string> FIXED_WORDS;
@@ -8,9 +10,12 @@ extern const std::vector<std::string> FIXED_WORDS;
 // Endereço Bitcoin alvo
 extern const std::string TARGET_ADDRESS;
 
-// Variáveis de controle
-extern bool found_address;
-extern bool should_exit;
+// Caminho de derivação BIP32 avaliado pelo kernel (bit 31 = hardened)
+extern const std::vector<uint32_t> DERIVATION_PATH;
+
+// Variáveis de controle (compartilhadas pelos workers de dispositivo)
+extern std::atomic<bool> found_address;
+extern std::atomic<bool> should_exit;
 extern uint64_t current_low;
 extern uint64_t current_high;
 
@@ -0,0 +1,55 @@
+#include "host_task_queue.hpp"
+#include <algorithm>
+#include <iostream>
+
+HostTaskQueue::HostTaskQueue(size_t threads) {
+    for (size_t i = 0; i < std::max<size_t>(1, threads); i++) {
+        threads_.emplace_back(&HostTaskQueue::loop, this);
+    }
+}
+
+HostTaskQueue::~HostTaskQueue() {
+    stop();
+}
+
+void HostTaskQueue::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void HostTaskQueue::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void HostTaskQueue::loop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;  // stopping_ e nada pendente
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "Erro em tarefa do host: " << e.what() << std::endl;
+        }
+    }
+}
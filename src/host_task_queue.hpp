@@ -0,0 +1,34 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fila de tarefas executadas por um pool de threads do host (confirmação de
+// acertos com OpenSSL, frases de amostra, logs). As threads dos dispositivos
+// só enfileiram e voltam a alimentar a GPU; com várias threads, acertos do
+// mesmo lote são confirmados em paralelo e sem ordem entre si.
+class HostTaskQueue {
+public:
+    explicit HostTaskQueue(size_t threads = 1);
+    ~HostTaskQueue();
+
+    HostTaskQueue(const HostTaskQueue&) = delete;
+    HostTaskQueue& operator=(const HostTaskQueue&) = delete;
+
+    void post(std::function<void()> task);
+
+    // Executa as tarefas pendentes e encerra as threads
+    void stop();
+
+private:
+    void loop();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
@@ -0,0 +1,815 @@
+#include "job_spec.hpp"
+#include "globals.hpp"
+#include "bitcoin_utils.hpp"
+#include "bip39_utils.hpp"
+#include "passphrase_space.hpp"
+#include "search_space.hpp"
+#include <openssl/sha.h>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Palavras de 32 bits de cada alvo comparadas no kernel
+const size_t MATCH_WORDS = 2;
+
+// Caminhos do job em árvore: filhos na ordem em que aparecem, `scripts` nos
+// nós onde algum caminho termina
+struct PathNode {
+    uint32_t index = 0;
+    uint32_t scripts = 0;
+    std::vector<PathNode> children;
+};
+
+PathNode path_tree(const std::vector<JobSpec::DerivationPath>& paths) {
+    PathNode root;
+    for (const auto& path : paths) {
+        PathNode* node = &root;
+        for (uint32_t index : path.indices) {
+            auto it = std::find_if(node->children.begin(), node->children.end(),
+                                   [&](const PathNode& child) { return child.index == index; });
+            if (it == node->children.end()) {
+                node->children.push_back(PathNode{index, 0, {}});
+                it = node->children.end() - 1;
+            }
+            node = &*it;
+        }
+        node->scripts |= path.scripts;
+    }
+    return root;
+}
+
+size_t count_steps(const PathNode& node, uint32_t gap) {
+    // Janela: as duas cadeias (externa e troco) e gap filhos em cada
+    size_t steps = node.children.size() + (node.scripts && gap ? 2 * (1 + gap) : 0);
+    for (const auto& child : node.children) {
+        steps += count_steps(child, gap);
+    }
+    return steps;
+}
+
+// Folhas da árvore (caminhos distintos com tipos de script)
+size_t count_leaves(const PathNode& node) {
+    size_t leaves = node.scripts ? 1 : 0;
+    for (const auto& child : node.children) {
+        leaves += count_leaves(child);
+    }
+    return leaves;
+}
+
+// JOB_DERIVATION em pré-ordem: STEP(profundidade, índice), LEAF(profundidade, scripts)
+void emit_derivation(std::ostream& out, const PathNode& node, size_t depth) {
+    if (node.scripts) {
+        out << " \\\n    LEAF(" << depth << ", " << node.scripts << "u)";
+    }
+    for (const auto& child : node.children) {
+        out << " \\\n    STEP(" << depth + 1 << ", 0x" << std::hex << child.index << std::dec
+            << "u)";
+        emit_derivation(out, child, depth + 1);
+    }
+}
+
+// Estado do SHA-512 depois de um bloco de 128 bytes (midstate)
+std::array<uint64_t, 8> sha512_midstate(const uint8_t* block) {
+    SHA512_CTX ctx;
+    SHA512_Init(&ctx);
+    SHA512_Update(&ctx, block, SHA512_CBLOCK);
+    std::array<uint64_t, 8> state;
+    std::copy(ctx.h, ctx.h + 8, state.begin());
+    return state;
+}
+
+}  // namespace
+
+JobSpec JobSpec::defaults() {
+    JobSpec job;
+    job.words = FIXED_WORDS;
+    job.pool_size = static_cast<uint32_t>(job.words.size());
+    job.slots.assign(12, {});
+    job.targets = {TARGET_ADDRESS};
+    job.paths = {{DERIVATION_PATH, Address::bit(ScriptType::P2PKH)}};
+    return job;
+}
+
+std::vector<uint32_t> JobSpec::parse_path(const std::string& text) {
+    std::vector<uint32_t> path;
+    std::stringstream in(text);
+    std::string level;
+
+    std::getline(in, level, '/');
+    if (level != "m") {
+        throw std::invalid_argument("Caminho de derivação deve começar com m/: " + text);
+    }
+    while (std::getline(in, level, '/')) {
+        bool hardened = !level.empty() && (level.back() == '\'' || level.back() == 'h');
+        if (hardened) {
+            level.pop_back();
+        }
+        if (level.empty() || level.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::invalid_argument("Nível inválido no caminho de derivação: " + text);
+        }
+        uint64_t index = std::stoull(level);
+        if (index >= 0x80000000ULL) {
+            throw std::invalid_argument("Índice grande demais no caminho de derivação: " + text);
+        }
+        path.push_back(static_cast<uint32_t>(index) | (hardened ? 0x80000000u : 0));
+    }
+    return path;
+}
+
+std::string JobSpec::format_path(const std::vector<uint32_t>& path) {
+    std::string text = "m";
+    for (uint32_t index : path) {
+        text += "/" + std::to_string(index & 0x7FFFFFFF) + ((index & 0x80000000) ? "'" : "");
+    }
+    return text;
+}
+
+uint32_t JobSpec::target_scripts() const {
+    uint32_t scripts = 0;
+    for (const auto& target : targets) {
+        scripts |= Address::bit(Address::decode(target).script);
+    }
+    return scripts;
+}
+
+size_t JobSpec::derivation_steps() const {
+    return count_steps(path_tree(paths), gap);
+}
+
+size_t JobSpec::keys_per_phrase() const {
+    return count_leaves(path_tree(paths)) * (gap ? 2 * gap : 1);
+}
+
+std::vector<std::vector<uint32_t>> JobSpec::leaf_paths(const DerivationPath& path) const {
+    if (gap == 0) {
+        return {path.indices};
+    }
+    std::vector<std::vector<uint32_t>> leaves;
+    for (uint32_t change = 0; change < 2; change++) {
+        for (uint32_t index = 0; index < gap; index++) {
+            leaves.push_back(path.indices);
+            leaves.back().push_back(change);
+            leaves.back().push_back(index);
+        }
+    }
+    return leaves;
+}
+
+JobSpec JobSpec::load(const std::string& file) {
+    std::ifstream in(file);
+    if (!in) {
+        throw std::runtime_error("Não foi possível abrir o arquivo de job: " + file);
+    }
+
+    JobSpec job;
+    uint32_t length = 12;
+    std::vector<std::pair<uint32_t, std::vector<std::string>>> constraints;
+
+    std::string line;
+    for (int line_number = 1; std::getline(in, line); line_number++) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key)) {
+            continue;
+        }
+
+        auto fail = [&](const std::string& message) {
+            return std::invalid_argument(file + ":" + std::to_string(line_number) + ": " + message);
+        };
+
+        if (key == "words") {
+            std::string word;
+            while (fields >> word) {
+                job.words.push_back(word);
+            }
+        } else if (key == "length") {
+            if (!(fields >> length)) {
+                throw fail("length sem valor numérico");
+            }
+        } else if (key == "target") {
+            std::string address;
+            if (!(fields >> address)) {
+                throw fail("target sem endereço");
+            }
+            job.targets.push_back(address);
+        } else if (key == "path") {
+            std::string text, script;
+            if (!(fields >> text)) {
+                throw fail("path sem caminho");
+            }
+            DerivationPath path;
+            path.indices = parse_path(text);
+            while (fields >> script) {
+                path.scripts |= Address::bit(Address::parse_script(script));
+            }
+            job.paths.push_back(path);
+        } else if (key == "gap") {
+            if (!(fields >> job.gap)) {
+                throw fail("gap sem valor numérico");
+            }
+        } else if (key == "known" || key == "slot") {
+            uint32_t position;
+            std::vector<std::string> candidates;
+            std::string word;
+            if (!(fields >> position)) {
+                throw fail(key + " espera <posição> <palavra>...");
+            }
+            while (fields >> word) {
+                candidates.push_back(word);
+            }
+            if (candidates.empty() || (key == "known" && candidates.size() != 1)) {
+                throw fail(key == "known" ? "known espera <posição> <palavra>"
+                                          : "slot espera <posição> <palavra> <palavra>...");
+            }
+            constraints.emplace_back(position, candidates);
+        } else if (key == "checksum") {
+            std::string value;
+            if (!(fields >> value) || (value != "on" && value != "off")) {
+                throw fail("checksum espera on ou off");
+            }
+            job.checksum = value == "on";
+        } else if (key == "dictionary") {
+            std::string name;
+            if (!(fields >> name)) {
+                throw fail("dictionary sem arquivo");
+            }
+            std::filesystem::path path(name);
+            if (path.is_relative()) {
+                path = std::filesystem::path(file).parent_path() / path;
+            }
+            std::ifstream list(path);
+            if (!list) {
+                throw fail("não foi possível abrir o dicionário " + path.string());
+            }
+            const size_t before = job.passphrases.size();
+            std::string entry;
+            while (std::getline(list, entry)) {
+                if (!entry.empty() && entry.back() == '\r') {
+                    entry.pop_back();
+                }
+                if (!entry.empty()) {
+                    job.passphrases.push_back(entry);
+                }
+            }
+            if (job.passphrases.size() == before) {
+                throw fail("dicionário vazio: " + path.string());
+            }
+        } else if (key == "mask") {
+            if (!job.mask.empty() || !(fields >> job.mask)) {
+                throw fail("mask espera uma única máscara");
+            }
+        } else {
+            throw fail("diretiva desconhecida: " + key);
+        }
+
+        std::string extra;
+        if (key != "words" && key != "slot" && key != "known" && key != "path" &&
+            (fields >> extra)) {
+            throw fail("valor a mais em " + key + ": " + extra);
+        }
+    }
+
+    if (job.targets.empty()) {
+        job.targets.push_back(TARGET_ADDRESS);
+    }
+    if (job.paths.empty()) {
+        // Com gap, a conta de DERIVATION_PATH (sem cadeia e índice)
+        auto account = DERIVATION_PATH;
+        if (job.gap > 0 && account.size() >= 2) {
+            account.resize(account.size() - 2);
+        }
+        job.paths.push_back({account, 0});
+    }
+    // Caminho sem script: todos os tipos dos alvos
+    const uint32_t target_types = job.target_scripts();
+    for (auto& path : job.paths) {
+        if (path.scripts == 0) {
+            path.scripts = target_types;
+        }
+    }
+
+    // Palavras de known/slot que não estão no pool entram na tabela depois
+    // dele, então só podem aparecer na posição que as cita
+    job.pool_size = static_cast<uint32_t>(job.words.size());
+    job.slots.assign(length, {});
+    for (const auto& [position, candidates] : constraints) {
+        if (position < 1 || position > length) {
+            throw std::invalid_argument("Posição fora da frase: " + std::to_string(position));
+        }
+        auto& slot = job.slots[position - 1];
+        if (!slot.empty()) {
+            throw std::invalid_argument("Posição restrita duas vezes: " +
+                                        std::to_string(position));
+        }
+        for (const auto& word : candidates) {
+            auto it = std::find(job.words.begin(), job.words.end(), word);
+            if (it == job.words.end()) {
+                job.words.push_back(word);
+                it = job.words.end() - 1;
+            }
+            uint32_t index = static_cast<uint32_t>(it - job.words.begin());
+            if (std::find(slot.begin(), slot.end(), index) != slot.end()) {
+                throw std::invalid_argument("Palavra repetida na posição " +
+                                            std::to_string(position) + ": " + word);
+            }
+            slot.push_back(index);
+        }
+    }
+
+    // Uma palavra fixa não pode aparecer em outra posição: tirar dos
+    // subconjuntos (que podem virar fixos e liberar mais cortes)
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t i = 0; i < job.slots.size(); i++) {
+            if (job.slots[i].size() != 1) {
+                continue;
+            }
+            uint32_t fixed = job.slots[i][0];
+            for (size_t j = 0; j < job.slots.size(); j++) {
+                auto& other = job.slots[j];
+                if (j == i || other.size() < 2) {
+                    continue;
+                }
+                auto it = std::find(other.begin(), other.end(), fixed);
+                if (it != other.end()) {
+                    other.erase(it);
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    job.validate();
+    return job;
+}
+
+void JobSpec::validate() const {
+    if (words.empty()) {
+        throw std::invalid_argument("Job sem palavras");
+    }
+    if (words.size() > 64) {
+        throw std::invalid_argument("Tabela com mais de 64 palavras");
+    }
+    // O kernel e o DispatchEngine trabalham com frases de 12 palavras
+    if (length() != 12) {
+        throw std::invalid_argument("Apenas frases de 12 palavras são suportadas, não " +
+                                    std::to_string(length()));
+    }
+
+    std::set<std::string> unique;
+    for (const auto& word : words) {
+        if (word.empty() || word.size() > MAX_WORD_BYTES) {
+            throw std::invalid_argument("Palavra com tamanho inválido: " + word);
+        }
+        for (char c : word) {
+            if (c <= ' ' || c > '~' || c == '"' || c == '\\') {
+                throw std::invalid_argument("Caractere não suportado na palavra: " + word);
+            }
+        }
+        if (!unique.insert(word).second) {
+            throw std::invalid_argument("Palavra repetida no pool: " + word);
+        }
+    }
+
+    if (pool_size > words.size()) {
+        throw std::invalid_argument("Pool maior que a tabela de palavras");
+    }
+    std::vector<bool> fixed(words.size(), false);
+    for (size_t i = 0; i < slots.size(); i++) {
+        for (uint32_t word : slots[i]) {
+            if (word >= words.size()) {
+                throw std::invalid_argument("Candidata fora da tabela na posição " +
+                                            std::to_string(i + 1));
+            }
+        }
+        if (slots[i].size() == 1) {
+            if (fixed[slots[i][0]]) {
+                throw std::invalid_argument("Palavra conhecida em duas posições: " +
+                                            words[slots[i][0]]);
+            }
+            fixed[slots[i][0]] = true;
+        }
+    }
+
+    // Pior caso: a candidata mais longa de cada posição restrita + as mais
+    // longas do pool livre nas posições livres
+    size_t bytes = length() - 1;
+    size_t free_slots = 0;
+    for (const auto& candidates : slots) {
+        size_t longest = 0;
+        for (uint32_t word : candidates) {
+            longest = std::max(longest, words[word].size());
+        }
+        bytes += longest;
+        free_slots += candidates.empty();
+    }
+    std::vector<size_t> free_lengths;
+    for (size_t w = 0; w < pool_size; w++) {
+        if (!fixed[w]) {
+            free_lengths.push_back(words[w].size());
+        }
+    }
+    if (free_lengths.size() < free_slots) {
+        throw std::invalid_argument("Pool com menos palavras livres que posições livres");
+    }
+    std::sort(free_lengths.rbegin(), free_lengths.rend());
+    for (size_t i = 0; i < free_slots; i++) {
+        bytes += free_lengths[i];
+    }
+    // +1: mnemonic_key também encaixa o espaço depois da última palavra
+    if (bytes + 1 > MAX_MNEMONIC_BYTES) {
+        throw std::invalid_argument("Frase pode passar de " + std::to_string(MAX_MNEMONIC_BYTES) +
+                                    " bytes, limite do kernel");
+    }
+
+    if (targets.empty() || targets.size() > MAX_TARGETS) {
+        throw std::invalid_argument("O job precisa de 1 a " + std::to_string(MAX_TARGETS) +
+                                    " endereços alvo");
+    }
+    const uint32_t target_types = target_scripts();  // decodifica (e valida) os alvos
+    if (paths.empty() || paths.size() > MAX_PATHS) {
+        throw std::invalid_argument("O job precisa de 1 a " + std::to_string(MAX_PATHS) +
+                                    " caminhos de derivação");
+    }
+    if (gap > MAX_GAP) {
+        throw std::invalid_argument("gap maior que " + std::to_string(MAX_GAP));
+    }
+    for (const auto& path : paths) {
+        if (path.indices.size() + (gap ? 2 : 0) > MAX_PATH_DEPTH) {
+            throw std::invalid_argument("Caminho de derivação com mais de " +
+                                        std::to_string(MAX_PATH_DEPTH) + " níveis");
+        }
+        if (path.scripts == 0 || (path.scripts & ~target_types)) {
+            throw std::invalid_argument("Caminho " + format_path(path.indices) +
+                                        " com tipo de script sem endereço alvo desse tipo");
+        }
+    }
+
+    if (passphrase_mode()) {
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].size() != 1) {
+                throw std::invalid_argument("O modo passphrase precisa de todas as posições "
+                                            "conhecidas (known); falta a " +
+                                            std::to_string(i + 1));
+            }
+        }
+        PassphraseSpace(passphrases, mask);  // valida o dicionário e a máscara
+    }
+}
+
+std::string JobSpec::known_phrase() const {
+    std::string phrase;
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (slots[i].size() != 1) {
+            throw std::logic_error("Posição sem palavra conhecida");
+        }
+        phrase += (i ? " " : "") + words[slots[i][0]];
+    }
+    return phrase;
+}
+
+bool JobSpec::known_checksum_ok() const {
+    // 132 bits dos índices na wordlist: 128 de entropia e 4 de checksum
+    const auto indices = wordlist_indices();
+    std::vector<uint8_t> bits;
+    for (const auto& slot : slots) {
+        for (int b = 10; b >= 0; b--) {
+            bits.push_back((indices[slot.at(0)] >> b) & 1);
+        }
+    }
+    uint8_t entropy[16] = {0};
+    for (size_t i = 0; i < 128; i++) {
+        entropy[i / 8] |= bits[i] << (7 - i % 8);
+    }
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    SHA256(entropy, sizeof(entropy), hash);
+    uint8_t checksum = 0;
+    for (size_t i = 128; i < 132; i++) {
+        checksum = static_cast<uint8_t>((checksum << 1) | bits[i]);
+    }
+    return (hash[0] >> 4) == checksum;
+}
+
+std::vector<uint16_t> JobSpec::wordlist_indices() const {
+    const auto& wordlist = BIP39Utils::get_test_wordlist();
+    std::vector<uint16_t> indices;
+    for (const auto& word : words) {
+        auto it = std::find(wordlist.begin(), wordlist.end(), word);
+        if (it == wordlist.end()) {
+            throw std::runtime_error("Palavra fora da wordlist BIP39: " + word);
+        }
+        indices.push_back(static_cast<uint16_t>(it - wordlist.begin()));
+    }
+    return indices;
+}
+
+std::string JobSpec::describe() const {
+    // Mesmo formato de antes dos arquivos de job: journals antigos da busca
+    // padrão continuam válidos
+    std::ostringstream out;
+    out << "words=";
+    for (size_t i = 0; i < words.size(); i++) {
+        if (i > 0) out << ",";
+        out << words[i];
+    }
+    out << ";length=" << length();
+    out << ";target=";
+    for (size_t i = 0; i < targets.size(); i++) {
+        out << (i ? "," : "") << targets[i];
+    }
+    // Scripts só quando diferem dos tipos dos alvos
+    const uint32_t target_types = target_scripts();
+    out << ";path=";
+    for (size_t p = 0; p < paths.size(); p++) {
+        const std::string text = format_path(paths[p].indices);
+        out << (p ? "," : "") << text.substr(std::min<size_t>(2, text.size()));
+        if (paths[p].scripts != target_types) {
+            for (uint32_t t = 0, first = 1; t < Address::SCRIPT_TYPES; t++) {
+                if (paths[p].scripts & (1u << t)) {
+                    out << (first ? ":" : "+") << Address::name(static_cast<ScriptType>(t));
+                    first = 0;
+                }
+            }
+        }
+    }
+    if (gap > 0) {
+        out << ";gap=" << gap;
+    }
+
+    bool first_known = true, first_slot = true;
+    std::ostringstream subsets;
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (slots[i].size() == 1) {
+            out << (first_known ? ";known=" : ",") << (i + 1) << ":" << words[slots[i][0]];
+            first_known = false;
+        } else if (slots[i].size() > 1) {
+            subsets << (first_slot ? ";slots=" : ",") << (i + 1) << ":";
+            for (size_t k = 0; k < slots[i].size(); k++) {
+                subsets << (k ? "|" : "") << words[slots[i][k]];
+            }
+            first_slot = false;
+        }
+    }
+    if (pool_size != words.size()) {
+        out << ";pool=" << pool_size;
+    }
+    out << subsets.str();
+    if (!checksum) {
+        out << ";checksum=off";
+    }
+    if (passphrase_mode()) {
+        // O dicionário entra pelo tamanho e pelo hash do conteúdo
+        out << ";passphrase=";
+        if (!passphrases.empty()) {
+            std::string joined;
+            for (const auto& entry : passphrases) {
+                joined += entry + "\n";
+            }
+            uint8_t hash[SHA256_DIGEST_LENGTH];
+            SHA256(reinterpret_cast<const uint8_t*>(joined.data()), joined.size(), hash);
+            out << "dictionary:" << passphrases.size() << ":"
+                << BitcoinUtils::bytes_to_hex(std::vector<uint8_t>(hash, hash + 8));
+        }
+        if (!mask.empty()) {
+            out << (passphrases.empty() ? "" : ",") << "mask:" << mask;
+        }
+    }
+    return out.str();
+}
+
+std::string JobSpec::kernel_header() const {
+    SearchSpace space(pool_size, slots);
+    const auto& free_words = space.free_words();
+    const auto& free_slots = space.free_slots();
+    const bool identity = free_words.size() == words.size();
+
+    std::ostringstream out;
+    out << "// Gerado por JobSpec::kernel_header: " << describe() << "\n"
+        << "#define JOB_SPECIALIZED 1\n"
+        << "#define WORD_LIST_SIZE " << words.size() << "\n"
+        << "#define PHRASE_LEN " << length() << "\n"
+        << "#define POOL_SIZE " << std::max<size_t>(1, free_words.size()) << "\n"
+        << "#define PERM_LEN " << free_slots.size() << "\n\n";
+
+    // Tabela de palavras na ordem do host
+    out << "__constant char wordsString[WORD_LIST_SIZE][" << MAX_WORD_BYTES << "] = {\n";
+    for (size_t i = 0; i < words.size(); i++) {
+        out << "    \"" << words[i] << "\"" << (i + 1 < words.size() ? "," : "") << "\n";
+    }
+    out << "};\n\n__constant int wordsLen[WORD_LIST_SIZE] = {";
+    for (size_t i = 0; i < words.size(); i++) {
+        out << (i ? ", " : "") << words[i].size();
+    }
+    out << "};\n\n";
+
+    // Cada palavra seguida do espaço em words big-endian: mnemonic_key monta
+    // a chave do HMAC com deslocamentos de 64 bits em vez de byte a byte
+    size_t longest = 0;
+    for (const auto& word : words) {
+        longest = std::max(longest, word.size());
+    }
+    const size_t chunks = (longest + 1 + 7) / 8;
+    out << "#define WORD_CHUNKS " << chunks << "\n"
+        << "__constant ulong wordsPacked[WORD_LIST_SIZE][WORD_CHUNKS] = {\n";
+    for (size_t i = 0; i < words.size(); i++) {
+        std::string bytes = words[i] + " ";
+        bytes.resize(chunks * 8, '\0');
+        out << "    {";
+        for (size_t c = 0; c < chunks; c++) {
+            uint64_t chunk = 0;
+            for (size_t b = 0; b < 8; b++) {
+                chunk = (chunk << 8) | static_cast<unsigned char>(bytes[c * 8 + b]);
+            }
+            out << (c ? ", " : "") << "0x" << std::hex << std::setw(16) << std::setfill('0')
+                << chunk << std::dec << "UL";
+        }
+        out << "}" << (i + 1 < words.size() ? "," : "") << "\n";
+    }
+    out << "};\n\n";
+
+    // Índices na wordlist BIP39 para o checksum (job_checksum_ok em main.cl).
+    // No modo passphrase a frase é fixa e o host confere o checksum antes.
+    const bool phrase_checksum = checksum && !passphrase_mode();
+    out << "#define JOB_CHECKSUM " << (phrase_checksum ? 1 : 0) << "\n";
+    if (phrase_checksum) {
+        auto indices = wordlist_indices();
+        out << "__constant ushort job_bip39[WORD_LIST_SIZE] = {";
+        for (size_t i = 0; i < indices.size(); i++) {
+            out << (i ? ", " : "") << indices[i];
+        }
+        out << "};\n";
+    }
+    out << "\n";
+
+    // Candidatas das posições livres e dos subconjuntos
+    if (!free_slots.empty() && !identity) {
+        out << "__constant uchar job_free_word[POOL_SIZE] = {";
+        for (size_t i = 0; i < free_words.size(); i++) {
+            out << (i ? ", " : "") << free_words[i];
+        }
+        out << "};\n";
+    }
+    for (uint32_t slot : space.subset_slots()) {
+        out << "__constant uchar job_slot" << slot << "[" << slots[slot].size() << "] = {";
+        for (size_t k = 0; k < slots[slot].size(); k++) {
+            out << (k ? ", " : "") << slots[slot][k];
+        }
+        out << "};\n";
+    }
+
+    // rank -> frase, mesma decomposição de SearchSpace::unrank. Os divisores
+    // são constantes, então % e / viram multiplicações.
+    out << "\n";
+    if (!free_slots.empty()) {
+        out << "void perm_unrank(ulong rank, uint *phrase);\n\n";
+    }
+    out << "// Frase do rank; false se repete palavra (descartada antes do PBKDF2)\n"
+        << "bool job_unrank(ulong rank, uint *phrase) {\n";
+    for (uint32_t slot : space.subset_slots()) {
+        out << "    phrase[" << slot << "] = job_slot" << slot << "[rank % "
+            << slots[slot].size() << "u];\n"
+            << "    rank /= " << slots[slot].size() << "u;\n";
+    }
+    if (!free_slots.empty()) {
+        out << "    uint perm[PERM_LEN];\n"
+            << "    perm_unrank(rank, perm);\n";
+    }
+    for (size_t i = 0, k = 0; i < slots.size(); i++) {
+        if (slots[i].size() == 1) {
+            out << "    phrase[" << i << "] = " << slots[i][0] << "u;  // "
+                << words[slots[i][0]] << "\n";
+        } else if (slots[i].empty()) {
+            out << "    phrase[" << i << "] = "
+                << (identity ? "perm[" + std::to_string(k) + "]"
+                             : "job_free_word[perm[" + std::to_string(k) + "]]")
+                << ";\n";
+            k++;
+        }
+    }
+    if (space.needs_distinct_check()) {
+        out << "    ulong used = 0;\n"
+            << "    for (int i = 0; i < PHRASE_LEN; i++) {\n"
+            << "        if (used & (1UL << phrase[i])) {\n"
+            << "            return false;\n"
+            << "        }\n"
+            << "        used |= 1UL << phrase[i];\n"
+            << "    }\n";
+    }
+    out << "    return true;\n}\n\n";
+
+    // Alvos por tipo de script (match_key_group em bip39.cl): hash160 em
+    // palavras little-endian, como sai de ripemd160_32; x do P2TR em limbs
+    // little-endian, como em ec.cl. O kernel compara só as 2 primeiras
+    // palavras (64 bits): o host confirma cada acerto por inteiro
+    // (confirm_hit), e um falso positivo (2^-64 por chave) só custa isso.
+    static const char* const MATCH_NAMES[Address::SCRIPT_TYPES] = {
+        "JOB_MATCH_P2PKH", "JOB_MATCH_P2SH_P2WPKH", "JOB_MATCH_P2WPKH", "JOB_MATCH_P2TR"};
+    std::vector<std::string> matches(Address::SCRIPT_TYPES);
+    for (const auto& address : targets) {
+        const AddressTarget target = Address::decode(address);
+        std::vector<uint32_t> words;
+        if (target.script == ScriptType::P2TR) {
+            for (int i = 0; i < 8; i++) {
+                const uint8_t* b = target.program.data() + 28 - 4 * i;
+                words.push_back((uint32_t(b[0]) << 24) | (uint32_t(b[1]) << 16) |
+                                (uint32_t(b[2]) << 8) | b[3]);
+            }
+        } else {
+            auto hash = BitcoinUtils::hash160_to_words(target.program);
+            words.assign(hash.begin(), hash.end());
+        }
+
+        std::ostringstream match;
+        match << "(";
+        for (size_t i = 0; i < MATCH_WORDS; i++) {
+            match << (i ? " && " : "") << "(v)[" << i << "] == 0x" << std::hex << std::setw(8)
+                  << std::setfill('0') << words[i] << std::dec << "u";
+        }
+        match << ")";
+        auto& line = matches[static_cast<uint32_t>(target.script)];
+        line += (line.empty() ? "  /* " : " || \\\n    /* ") + address + " */ \\\n    " +
+                match.str();
+    }
+    for (uint32_t t = 0; t < Address::SCRIPT_TYPES; t++) {
+        out << "#define " << MATCH_NAMES[t] << "(v)"
+            << (matches[t].empty() ? " 0" : " \\\n   " + matches[t].substr(1)) << "\n";
+    }
+
+    // Árvore dos caminhos: prefixos comuns (m/84'/0'/0' de .../0/0 e
+    // .../1/0) viram um só STEP
+    const PathNode tree = path_tree(paths);
+    size_t depth = 0;
+    for (const auto& path : paths) {
+        depth = std::max(depth, path.indices.size());
+    }
+    out << "\n// " << paths.size() << " caminhos, " << count_steps(tree, gap) << " derivações\n"
+        << "#define JOB_PATH_DEPTH " << depth << "\n"
+        << "#define JOB_GAP " << gap << "u\n"
+        << "#define JOB_KEYS " << keys_per_phrase() << "u\n"
+        << "#define JOB_DERIVATION(STEP, LEAF)";
+    emit_derivation(out, tree, 0);
+    out << "\n\n";
+
+    out << "#define JOB_PASSPHRASE " << (passphrase_mode() ? 1 : 0) << "\n";
+    if (passphrase_mode()) {
+        const PassphraseSpace space(passphrases, mask);
+        const auto& charsets = space.charsets();
+        out << "#define JOB_DICT_WORDS " << passphrases.size() << "u\n"
+            << "#define JOB_MASK_LEN " << charsets.size() << "\n"
+            << "#define JOB_MASK_SIZE " << space.mask_size() << "UL\n";
+
+        // Chave HMAC do PBKDF2 é a frase conhecida: os estados SHA-512
+        // depois dos blocos chave XOR ipad e XOR opad valem para o job todo
+        // (passphrase_to_seed em main.cl)
+        const std::string phrase = known_phrase();
+        static const char* const KEY_NAMES[2] = {"job_key_inner", "job_key_outer"};
+        static const uint8_t PADS[2] = {0x36, 0x5c};
+        for (int k = 0; k < 2; k++) {
+            uint8_t block[SHA512_CBLOCK];
+            for (size_t i = 0; i < sizeof(block); i++) {
+                block[i] = (i < phrase.size() ? static_cast<uint8_t>(phrase[i]) : 0) ^ PADS[k];
+            }
+            const auto state = sha512_midstate(block);
+            out << "__constant ulong " << KEY_NAMES[k] << "[8] = {";
+            for (size_t i = 0; i < state.size(); i++) {
+                out << (i % 4 ? ", " : (i ? ",\n    " : "\n    ")) << "0x" << std::hex
+                    << std::setw(16) << std::setfill('0') << state[i] << std::dec << "UL";
+            }
+            out << "\n};\n";
+        }
+
+        // Máscara: uma tabela por posição com mais de um caractere e
+        // divisores constantes, como em job_unrank
+        for (size_t i = 0; i < charsets.size(); i++) {
+            if (charsets[i].size() < 2) {
+                continue;
+            }
+            out << "__constant uchar job_mask" << i << "[" << charsets[i].size() << "] = {";
+            for (size_t c = 0; c < charsets[i].size(); c++) {
+                out << (c ? ", " : "") << static_cast<int>(charsets[i][c]);
+            }
+            out << "};\n";
+        }
+        out << "\n// Caracteres da máscara do rank (primeira posição varia mais rápido)\n"
+            << "void job_mask(ulong rank, uchar *mask) {\n";
+        for (size_t i = 0; i < charsets.size(); i++) {
+            if (charsets[i].size() == 1) {
+                out << "    mask[" << i << "] = " << static_cast<int>(charsets[i][0]) << "u;\n";
+                continue;
+            }
+            out << "    mask[" << i << "] = job_mask" << i << "[rank % " << charsets[i].size()
+                << "u];\n"
+                << "    rank /= " << charsets[i].size() << "u;\n";
+        }
+        out << "}\n\n";
+    }
+    return out.str();
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "address.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Parâmetros de uma busca: pool de palavras, posições conhecidas, endereços
+// alvo e caminhos de derivação. Vem de um arquivo de job (--job) ou dos
+// valores padrão de globals.cpp. O host gera a partir dele o cabeçalho do
+// kernel, então trocar de busca não exige recompilar o programa.
+class JobSpec {
+public:
+    // Limites do kernel: frase num único bloco HMAC, caminho em BIP32_MAX_DEPTH;
+    // caminhos e alvos viram código desenrolado no kernel
+    static const size_t MAX_MNEMONIC_BYTES = 128;
+    static const size_t MAX_WORD_BYTES = 16;
+    static const size_t MAX_PATH_DEPTH = 8;
+    static const size_t MAX_PATHS = 16;
+    static const size_t MAX_TARGETS = 16;
+    static const uint32_t MAX_GAP = 100;
+
+    // Caminho de derivação e os tipos de script avaliados na chave dele
+    struct DerivationPath {
+        std::vector<uint32_t> indices;   // bit 31 = hardened
+        uint32_t scripts = 0;            // bits Address::bit(ScriptType)
+    };
+
+    std::vector<std::string> words;   // tabela; o índice é o mesmo no host e no device
+    uint32_t pool_size = 0;           // words[0, pool_size) é o pool das posições livres
+    // Candidatas de cada posição (índices em words): vazio = qualquer palavra
+    // livre do pool, uma = posição conhecida, várias = subconjunto
+    std::vector<std::vector<uint32_t>> slots;
+    // Endereços procurados (base58 ou bech32/bech32m); um acerto em qualquer
+    // um encerra a busca
+    std::vector<std::string> targets;
+    // Todos são avaliados com uma só seed e chave mestra por frase
+    std::vector<DerivationPath> paths;
+    // Janela de endereços: com gap > 0 cada caminho é o de uma conta
+    // (m/84'/0'/0') e as chaves testadas são conta/0/i e conta/1/i, i < gap
+    uint32_t gap = 0;
+    // Só frases com checksum BIP39 válido chegam ao PBKDF2 (1 em 16)
+    bool checksum = true;
+    // Modo passphrase: a frase é conhecida (todas as posições fixas) e o
+    // espaço é o das passphrases, palavras do dicionário seguidas da máscara
+    // (PassphraseSpace)
+    std::vector<std::string> passphrases;
+    std::string mask;
+
+    // FIXED_WORDS, TARGET_ADDRESS e DERIVATION_PATH (P2PKH), 12 posições livres
+    static JobSpec defaults();
+
+    // Arquivo de job, uma diretiva por linha ('#' inicia comentário):
+    //   words  <palavra> <palavra> ...   (pode repetir; acrescenta ao pool)
+    //   length 12                        (única suportada por enquanto)
+    //   target <endereço>                (pode repetir; 1..., 3..., bc1q..., bc1p...)
+    //   path   m/84'/0'/0'/0/0 [script]  (pode repetir; scripts p2pkh,
+    //                                     p2sh-p2wpkh, p2wpkh, p2tr; sem
+    //                                     script: os tipos dos alvos)
+    //   gap    <n>                       (caminhos de conta; testa /0/0../0/n-1
+    //                                     e /1/0../1/n-1 de cada um)
+    //   known  <posição 1..n> <palavra>
+    //   slot   <posição 1..n> <palavra> <palavra> ...   (subconjunto)
+    //   checksum on|off                  (off: testar também checksum inválido)
+    //   dictionary <arquivo>             (passphrases, uma por linha; pode repetir;
+    //                                     relativo ao arquivo de job)
+    //   mask   <máscara>                 (hashcat: ?l ?u ?d ?h ?H ?s ?a ??)
+    // Palavras de known/slot fora do pool entram na tabela, mas não no pool.
+    static JobSpec load(const std::string& file);
+
+    static std::vector<uint32_t> parse_path(const std::string& text);
+    // m/44'/0'/0'/0/0
+    static std::string format_path(const std::vector<uint32_t>& path);
+
+    // Tipos de script dos alvos (bits Address::bit)
+    uint32_t target_scripts() const;
+    // Derivações por frase com os prefixos comuns dos caminhos feitos uma vez
+    size_t derivation_steps() const;
+    // Chaves comparadas por frase: caminhos distintos vezes a janela do gap
+    size_t keys_per_phrase() const;
+    // Caminhos completos das chaves testadas de `path` (um só sem gap)
+    std::vector<std::vector<uint32_t>> leaf_paths(const DerivationPath& path) const;
+
+    uint32_t length() const { return static_cast<uint32_t>(slots.size()); }
+
+    bool passphrase_mode() const { return !passphrases.empty() || !mask.empty(); }
+    // Frase das posições conhecidas (modo passphrase)
+    std::string known_phrase() const;
+    // Checksum BIP39 da frase conhecida; lança std::runtime_error como
+    // wordlist_indices
+    bool known_checksum_ok() const;
+
+    // Lança std::invalid_argument se o job não cabe no kernel
+    void validate() const;
+
+    // Índice de cada palavra da tabela na wordlist BIP39 (wordlist-ptbr.txt),
+    // usado no checksum; lança std::runtime_error se alguma não estiver nela
+    std::vector<uint16_t> wordlist_indices() const;
+
+    // Identificação da busca gravada no journal
+    std::string describe() const;
+
+    // Código OpenCL com as constantes da busca (tabela de palavras,
+    // comprimentos, candidatas por posição, índices BIP39, alvos por tipo de
+    // script e a árvore de caminhos) e job_unrank, na mesma ordem de dígitos
+    // de SearchSpace; compilado antes de main.cl. No modo passphrase, também
+    // os midstates da chave HMAC (a frase conhecida) e job_mask, na ordem de
+    // PassphraseSpace.
+    std::string kernel_header() const;
+};
@@ -0,0 +1,98 @@
+#ifndef ADDRESS_CL
+#define ADDRESS_CL
+
+#include "sha256.cl"
+#include "ripemd160.cl"
+#include "ec.cl"
+
+// Valores comparados para cada tipo de script de uma chave (Address no
+// host): hash160 da chave pública (P2PKH, P2WPKH), hash160 do redeem script
+// 0x00 0x14 <hash160> (P2SH-P2WPKH) e x da chave de saída BIP341 (P2TR).
+// Os bits são os de ScriptType (address.hpp).
+
+#define SCRIPT_P2PKH 1u
+#define SCRIPT_P2SH_P2WPKH 2u
+#define SCRIPT_P2WPKH 4u
+#define SCRIPT_P2TR 8u
+
+// hash160 da chave pública comprimida (x em limbs, paridade de y)
+void hash160_pubkey(const uint *x, const uint *y, uint *hash160) {
+    uint digest[8];
+    sha256_pubkey(0x02 | (y[0] & 1), x, digest);
+    ripemd160_32(digest, hash160);
+}
+
+// hash160 do redeem script P2SH-P2WPKH: OP_0 PUSH20 <hash160> (22 bytes).
+// hash160 em words little-endian, como sai de ripemd160_32.
+void hash160_p2wpkh_script(const uint *key_hash, uint *hash160) {
+    uint block[16] = {0x00140000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 176};
+    for (int j = 0; j < 20; j++) {
+        const uint b = (key_hash[j >> 2] >> ((j & 3) * 8)) & 0xff;
+        const int pos = j + 2;
+        block[pos >> 2] |= b << (24 - 8 * (pos & 3));
+    }
+    block[5] |= 0x8000;  // padding no byte 22
+
+    uint digest[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    sha256_process(digest, block);
+    ripemd160_32(digest, hash160);
+}
+
+// Estado SHA-256 depois do bloco SHA256("TapTweak") || SHA256("TapTweak")
+// do hash marcado do BIP340
+__constant uint TAPTWEAK_MIDSTATE[8] = {0xd129a2f3, 0x701c655d, 0x6583b6c3, 0xb9419727,
+                                        0x95f4e232, 0x94fd54f4, 0xa2ae8d85, 0x47ca590b};
+
+// x da chave de saída P2TR sem script tree: Q = P + t * G, com P de y par e
+// t = hash "TapTweak" de x(P). t * G sai de point_mul_g (tabela fixa ou
+// wNAF) e a soma fica jacobiana, então o grupo todo divide uma inversão
+// (inv_mod_group); todos os work-items chamam.
+void taproot_output_x_group(const uint *x, const uint *y, uint *qx, bool active,
+                            __local uint *tree, __global const uint *table) {
+    uint qy[8], qz[8] = {1, 0, 0, 0, 0, 0, 0, 0};
+    if (active) {
+        uint block[16];
+        for (int i = 0; i < 8; i++) {
+            block[i] = x[7 - i];
+        }
+        block[8] = 0x80000000;
+        for (int i = 9; i < 15; i++) {
+            block[i] = 0;
+        }
+        block[15] = 768;  // 96 bytes em bits
+
+        uint digest[8];
+        for (int i = 0; i < 8; i++) {
+            digest[i] = TAPTWEAK_MIDSTATE[i];
+        }
+        sha256_process(digest, block);
+
+        // t >= n invalida a chave no BIP341; a chance é desprezível e o host
+        // confirma o acerto
+        uint t[8];
+        for (int i = 0; i < 8; i++) {
+            t[i] = digest[7 - i];
+        }
+        uint n[8] = {SECP256K1_N_VALUES};
+        if (!is_less(t, n)) {
+            sub(t, t, n);
+        }
+
+        uint even_y[8];
+        if (y[0] & 1) {
+            uint p[8] = {SECPK256K_VALUES};
+            sub(even_y, p, y);
+        } else {
+            copy_eight(even_y, y);
+        }
+        point_mul_g(qx, qy, qz, t, table);
+        point_add_xy(qx, qy, qz, x, even_y);
+    }
+    inv_mod_group(qz, tree);
+    if (active) {
+        point_to_affine(qx, qy, qz);
+    }
+}
+
+#endif // ADDRESS_CL
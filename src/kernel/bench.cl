@@ -0,0 +1,215 @@
+// Arquivo: bench.cl
+// Kernels de benchmark: um estágio do pipeline do kernel verify por kernel.
+// Cada estágio lê a saída do anterior (seed -> chave -> ponto -> hash160),
+// então os dados são os mesmos da busca real.
+
+#include "main.cl"
+#include "bip32.cl"
+
+// Enumeração: rank -> índices das palavras
+__kernel void bench_enumerate(const ulong rank_offset, __global uint* out) {
+    uint phrase[PHRASE_LEN];
+    job_unrank(rank_offset + get_global_id(0), phrase);
+
+    uint acc = 0;
+    for (int i = 0; i < PHRASE_LEN; i++) {
+        acc = acc * 31 + phrase[i];
+    }
+    out[get_global_id(0)] = acc;
+}
+
+// Checksum BIP39 (job_checksum_ok): 132 bits dos índices na wordlist
+// completa, SHA-256 dos 128 bits de entropia e comparação dos 4 bits finais
+#if JOB_CHECKSUM
+__kernel void bench_checksum(const ulong rank_offset, __global uint* out) {
+    uint phrase[PHRASE_LEN];
+    job_unrank(rank_offset + get_global_id(0), phrase);
+    out[get_global_id(0)] = job_checksum_ok(phrase);
+}
+#endif
+
+// PBKDF2-HMAC-SHA512 (2048 iterações)
+__kernel void bench_pbkdf2(const ulong rank_offset, __global ulong* seeds) {
+    uint phrase[PHRASE_LEN];
+    ulong seed[8];
+
+    job_unrank(rank_offset + get_global_id(0), phrase);
+    mnemonic_to_seed(phrase, seed);
+
+    for (int i = 0; i < 8; i++) {
+        seeds[get_global_id(0) * 8 + i] = seed[i];
+    }
+}
+
+// PBKDF2 como era antes da chave ir direto para os midstates: string de 128
+// bytes, chave em 16 words e blocos inner/outer de 32 words vivos durante as
+// 2048 iterações. Mantido só para o bench comparar memória privada
+// (CL_KERNEL_PRIVATE_MEM_SIZE) e velocidade com bench_pbkdf2.
+__constant ulong gLegacyOuterTail[16] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0x8000000000000000UL, 0, 0, 0, 0, 0, 0, 1536UL
+};
+
+void pbkdf2_legacy(ulong *inner_data, ulong *outer_data, ulong *T) {
+    ulong U[8], OU[8], GU[8];
+    INIT_SHA512(GU);
+    INIT_SHA512(OU);
+
+    sha512_procces(inner_data, GU);
+    sha512_procces(outer_data, OU);
+    COPY_EIGHT(U, GU);
+    sha512_procces(inner_data + 16, U);
+    COPY_EIGHT(outer_data + 16, U);
+    COPY_EIGHT(T, OU);
+    sha512_procces(outer_data + 16, T);
+    COPY_EIGHT(U, T);
+
+    inner_data[24] = 0x8000000000000000UL;
+    for (int i = 25; i < 31; i++) {
+        inner_data[i] = 0;
+    }
+    inner_data[31] = 1536UL;
+
+    for (ushort i = 1; i < 2048; ++i) {
+        COPY_EIGHT(inner_data + 16, U);
+        COPY_EIGHT(U, GU);
+        sha512_procces(inner_data + 16, U);
+        COPY_EIGHT(outer_data + 16, U);
+        COPY_EIGHT(U, OU);
+        sha512_procces(outer_data + 16, U);
+        COPY_EIGHT_XOR(T, U);
+    }
+}
+
+__kernel void bench_pbkdf2_legacy(const ulong rank_offset, __global ulong* seeds) {
+    uint phrase[PHRASE_LEN];
+    ulong seed[8];
+    ulong inner_data[32];
+    ulong outer_data[32];
+    ulong mnemonicLong[16];
+    uchar mnemonicString[128] = {0};
+    uint offset = 0;
+
+    job_unrank(rank_offset + get_global_id(0), phrase);
+
+    for (int i = 0; i < PHRASE_LEN; i++) {
+        uint y = phrase[i];
+        for (int j = 0; j < wordsLen[y]; j++) {
+            mnemonicString[offset + j] = wordsString[y][j];
+        }
+        offset += wordsLen[y];
+        mnemonicString[offset++] = ' ';
+    }
+    mnemonicString[offset - 1] = '\0';
+
+    for (int i = 0; i < 16; i++) {
+        mnemonicLong[i] = 0;
+        for (int j = 0; j < 8; j++) {
+            mnemonicLong[i] = (mnemonicLong[i] << 8) | mnemonicString[i * 8 + j];
+        }
+    }
+
+    for (int i = 0; i < 16; i++) {
+        inner_data[i] = mnemonicLong[i] ^ IPAD;
+        outer_data[i] = mnemonicLong[i] ^ OPAD;
+        inner_data[i + 16] = gSaltBlock[i];
+        outer_data[i + 16] = gLegacyOuterTail[i];
+    }
+
+    pbkdf2_legacy(inner_data, outer_data, seed);
+
+    for (int i = 0; i < 8; i++) {
+        seeds[get_global_id(0) * 8 + i] = seed[i];
+    }
+}
+
+// Chave mestra + caminho BIP32
+__kernel void bench_bip32(__global const ulong* seeds,
+                          __constant uint* path,
+                          const uint path_len,
+                          __global uint* keys) {
+    ulong seed[8];
+    for (int i = 0; i < 8; i++) {
+        seed[i] = seeds[get_global_id(0) * 8 + i];
+    }
+
+    uint key[8];
+    ulong chain[4];
+    bip32_master_key(seed, key, chain);
+    for (uint i = 0; i < path_len && i < BIP32_MAX_DEPTH; i++) {
+        bip32_derive_child(key, chain, path[i]);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        keys[get_global_id(0) * 8 + i] = key[i];
+    }
+}
+
+// k * G (afim)
+__kernel void bench_point_mul(__global const uint* keys, __global uint* points) {
+    uint key[8], x[8], y[8];
+    for (int i = 0; i < 8; i++) {
+        key[i] = keys[get_global_id(0) * 8 + i];
+    }
+
+    point_mul_xy(x, y, key);
+
+    for (int i = 0; i < 8; i++) {
+        points[get_global_id(0) * 16 + i] = x[i];
+        points[get_global_id(0) * 16 + 8 + i] = y[i];
+    }
+}
+
+// k * G (afim) com uma inversão por grupo (point_mul_xy_group) e, com
+// EC_FIXED_BASE, a tabela fixa de G; o host confere a saída com a de
+// bench_point_mul (wNAF)
+__kernel void bench_point_mul_group(__global const uint* keys, __global uint* points,
+                                    __global const uint* ec_table) {
+    __local uint ec_tree[EC_GROUP_TREE_SIZE];
+    uint key[8], x[8], y[8];
+    for (int i = 0; i < 8; i++) {
+        key[i] = keys[get_global_id(0) * 8 + i];
+    }
+
+    point_mul_xy_group(x, y, key, true, ec_tree, ec_table);
+
+    for (int i = 0; i < 8; i++) {
+        points[get_global_id(0) * 16 + i] = x[i];
+        points[get_global_id(0) * 16 + 8 + i] = y[i];
+    }
+}
+
+// k * P (afim) com P variável (point_mul_xy_var, GLV): P vem de points e o
+// escalar de keys, item a item
+__kernel void bench_point_mul_var(__global const uint* keys, __global const uint* points,
+                                  __global uint* out) {
+    uint key[8], px[8], py[8], x[8], y[8];
+    for (int i = 0; i < 8; i++) {
+        key[i] = keys[get_global_id(0) * 8 + i];
+        px[i] = points[get_global_id(0) * 16 + i];
+        py[i] = points[get_global_id(0) * 16 + 8 + i];
+    }
+
+    point_mul_xy_var(x, y, px, py, key);
+
+    for (int i = 0; i < 8; i++) {
+        out[get_global_id(0) * 16 + i] = x[i];
+        out[get_global_id(0) * 16 + 8 + i] = y[i];
+    }
+}
+
+// hash160 da chave pública comprimida
+__kernel void bench_hash160(__global const uint* points, __global uint* hashes) {
+    uint x[8], digest[8], hash160[5];
+    for (int i = 0; i < 8; i++) {
+        x[i] = points[get_global_id(0) * 16 + i];
+    }
+    uint prefix = 0x02 | (points[get_global_id(0) * 16 + 8] & 1);
+
+    sha256_pubkey(prefix, x, digest);
+    ripemd160_32(digest, hash160);
+
+    for (int i = 0; i < 5; i++) {
+        hashes[get_global_id(0) * 5 + i] = hash160[i];
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef BIP32_CL
+#define BIP32_CL
+
+#include "sha512_hmac.cl"
+#include "sha256.cl"
+#include "ripemd160.cl"
+#include "ec.cl"
+
+// Derivação BIP32 no device, equivalente a BitcoinUtils::derive_private_key.
+// Chaves privadas e coordenadas ficam em 8 limbs little-endian (formato de
+// ec.cl); chain codes ficam em 4 ulongs big-endian (formato do SHA-512).
+
+#define BIP32_HARDENED 0x80000000U
+
+#ifndef BIP32_MAX_DEPTH
+#define BIP32_MAX_DEPTH 8
+#endif
+
+// 4 ulongs big-endian (saída do SHA-512) -> 8 limbs little-endian
+inline void ulong_to_limbs(const ulong *in, uint *out) {
+    for (int i = 0; i < 4; i++) {
+        out[7 - 2 * i] = (uint)(in[i] >> 32);
+        out[6 - 2 * i] = (uint)in[i];
+    }
+}
+
+// Chave mestra: HMAC-SHA512(key = "Bitcoin seed", data = seed)
+void bip32_master_key(const ulong *seed, uint *key, ulong *chain) {
+    ulong hmac_key[16] = {0x426974636f696e20UL, 0x7365656400000000UL,
+                          0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    ulong message[16];
+    ulong I[8];
+
+    for (int i = 0; i < 8; i++) {
+        message[i] = seed[i];
+    }
+    message[8] = 0x8000000000000000UL;
+    for (int i = 9; i < 15; i++) {
+        message[i] = 0;
+    }
+    message[15] = 1536UL;  // (128 + 64) * 8
+
+    hmac_sha512_block(hmac_key, message, I);
+
+    ulong_to_limbs(I, key);
+    chain[0] = I[4];
+    chain[1] = I[5];
+    chain[2] = I[6];
+    chain[3] = I[7];
+}
+
+// HMAC do CKDpriv com prefixo || valor já prontos (0x00 || chave privada
+// ou a chave pública comprimida do pai); atualiza (key, chain)
+void bip32_ckd(uint *key, ulong *chain, uint index, uint prefix, const uint *value) {
+    // prefixo (1 byte) || valor (32 bytes) || index (4 bytes) || 0x80
+    ulong v[4];
+    for (int i = 0; i < 4; i++) {
+        v[i] = ((ulong)value[7 - 2 * i] << 32) | value[6 - 2 * i];
+    }
+
+    ulong message[16];
+    message[0] = ((ulong)prefix << 56) | (v[0] >> 8);
+    message[1] = (v[0] << 56) | (v[1] >> 8);
+    message[2] = (v[1] << 56) | (v[2] >> 8);
+    message[3] = (v[2] << 56) | (v[3] >> 8);
+    message[4] = (v[3] << 56) | ((ulong)index << 24) | 0x800000UL;
+    for (int i = 5; i < 15; i++) {
+        message[i] = 0;
+    }
+    message[15] = 1320UL;  // (128 + 37) * 8
+
+    ulong hmac_key[16] = {chain[0], chain[1], chain[2], chain[3],
+                          0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    ulong I[8];
+    hmac_sha512_block(hmac_key, message, I);
+
+    // child = (IL + key) mod n
+    uint il[8];
+    ulong_to_limbs(I, il);
+    add_mod_n(key, il, key);
+
+    chain[0] = I[4];
+    chain[1] = I[5];
+    chain[2] = I[6];
+    chain[3] = I[7];
+}
+
+// CKDpriv: deriva o filho `index` de (key, chain) no próprio lugar
+void bip32_derive_child(uint *key, ulong *chain, uint index) {
+    uint prefix;
+    uint value[8];
+
+    if (index & BIP32_HARDENED) {
+        // Hardened: 0x00 || chave privada
+        prefix = 0;
+        copy_eight(value, key);
+    } else {
+        // Normal: chave pública comprimida do pai
+        uint y[8];
+        point_mul_xy(value, y, key);
+        prefix = 0x02 | (y[0] & 1);
+    }
+    bip32_ckd(key, chain, index, prefix, value);
+}
+
+// bip32_derive_child com a chave pública do pai calculada pelo grupo todo
+// (point_mul_xy_group, `table` é a tabela de G se EC_FIXED_BASE). `index`
+// precisa ser o mesmo em todo o grupo.
+void bip32_derive_child_group(uint *key, ulong *chain, uint index, bool active,
+                              __local uint *tree, __global const uint *table) {
+    uint prefix;
+    uint value[8];
+
+    if (index & BIP32_HARDENED) {
+        prefix = 0;
+        copy_eight(value, key);
+    } else {
+        uint y[8];
+        point_mul_xy_group(value, y, key, active, tree, table);
+        prefix = 0x02 | (y[0] & 1);
+    }
+    if (active) {
+        bip32_ckd(key, chain, index, prefix, value);
+    }
+}
+
+// hash160 da chave pública comprimida de uma chave privada
+void bip32_hash160(const uint *key, uint *hash160) {
+    uint x[8], y[8];
+    uint digest[8];
+
+    point_mul_xy(x, y, key);
+    sha256_pubkey(0x02 | (y[0] & 1), x, digest);
+    ripemd160_32(digest, hash160);
+}
+
+#endif // BIP32_CL
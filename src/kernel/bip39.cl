@@ -1,137 +1,396 @@
 // Arquivo: bip39.cl
-// Kernel OpenCL para busca de frases BIP39
-
-// Constantes do alvo
-#define TARGET_HIGH 0xA54FF53A5F1D36F1ul
-#define TARGET_LOW  0x510E527FADE682D1ul
-
-// Macros para operações SHA512
-#define CH(x,y,z) ((x & y) ^ (~x & z))
-#define MAJ(x,y,z) ((x & y) ^ (x & z) ^ (y & z))
-#define ROTR64(x,n) rotate(x, (ulong)(64-n))
-#define SHR(x,n)    (x >> n)
-#define SIGMA0(x) (ROTR64(x,28) ^ ROTR64(x,34) ^ ROTR64(x,39))
-#define SIGMA1(x) (ROTR64(x,14) ^ ROTR64(x,18) ^ ROTR64(x,41))
-#define sigma0(x) (ROTR64(x,1)  ^ ROTR64(x,8)  ^ SHR(x,7))
-#define sigma1(x) (ROTR64(x,19) ^ ROTR64(x,61) ^ SHR(x,6))
-
-// Constantes SHA512
-__constant ulong k[] = {
-    0x428a2f98d728ae22ul, 0x7137449123ef65cdul,
-    0xb5c0fbcfec4d3b2ful, 0xe9b5dba58189dbbcul,
-    0x3956c25bf348b538ul, 0x59f111f1b605d019ul,
-    0x923f82a4af194f9bul, 0xab1c5ed5da6d8118ul,
-    0xd807aa98a3030242ul, 0x12835b0145706fbel,
-    0x243185be4ee4b28cul, 0x550c7dc3d5ffb4e2ul,
-    0x72be5d74f27b896ful, 0x80deb1fe3b1696b1ul,
-    0x9bdc06a725c71235ul, 0xc19bf174cf692694ul
-};
-
-// Função para gerar frase
-void generate_phrase(ulong id, __global uint* phrase) {
-    // Array para controlar palavras disponíveis
-    uint available[34];
-    uint num_available = 34;
-    
-    // Inicializar array de palavras disponíveis
-    for(uint i = 0; i < 34; i++) {
-        available[i] = i;
-    }
-    
-    // Usar o id como semente para gerar números pseudo-aleatórios
-    ulong seed = id;
-    
-    // Gerar cada palavra da frase
-    for(int i = 0; i < 12; i++) {
-        // Gerar próximo número pseudo-aleatório
-        seed = seed * 6364136223846793005UL + 1;
-        
-        // Selecionar índice aleatório das palavras disponíveis
-        uint idx = (uint)(seed >> 32) % num_available;
-        
-        // Usar a palavra selecionada
-        phrase[i] = available[idx];
-        
-        // Remover palavra usada movendo a última palavra disponível para esta posição
-        available[idx] = available[num_available - 1];
-        num_available--;
+// Kernel OpenCL para busca de frases BIP39: rank -> frase -> checksum
+// (filter) -> PBKDF2 -> chave mestra BIP32 -> caminhos de derivação ->
+// scripts de cada chave -> comparação com os alvos (verify). No modo
+// passphrase (JOB_PASSPHRASE) a frase é fixa e o rank escolhe a passphrase.
+
+#include "main.cl"
+#include "bip32.cl"
+#include "address.cl"
+
+// Alvos e caminhos são constantes do cabeçalho do job: o compilador
+// desenrola a árvore de derivação e compara com imediatos
+#if JOB_PATH_DEPTH + (JOB_GAP ? 2 : 0) > BIP32_MAX_DEPTH
+#error "Caminho de derivação do job maior que BIP32_MAX_DEPTH"
+#endif
+
+// Buffer de estado de cada lote (DispatchEngine): STATUS_COUNT conta as
+// frases aprovadas pelo filter ou, no modo persistente, os blocos pegos;
+// STATUS_HITS conta os acertos. Os ranks dos acertos vão para `hits`, uma
+// fila só de escrita com HIT_QUEUE_SIZE posições; acertos além disso só são
+// contados. O host lê o estado a cada lote e a fila só se houver acerto.
+// STATUS_DISTINCT a STATUS_KEYS são os contadores por estágio da telemetria
+// (STAGE_COUNTERS, na ordem): frases sem palavra repetida, aprovadas no
+// checksum, com PBKDF2 concluído e chaves públicas comparadas (JOB_KEYS por
+// frase).
+#define STATUS_COUNT 0
+#define STATUS_HITS 1
+#define STATUS_DISTINCT 2
+#define STATUS_ACCEPTED 3
+#define STATUS_SEEDS 4
+#define STATUS_KEYS 5
+#define STAGE_COUNTERS 4
+#ifndef HIT_QUEUE_SIZE
+#define HIT_QUEUE_SIZE 64
+#endif
+
+// Função para gerar frase: o rank é convertido de forma bijetiva em
+// candidatas por posição (job_unrank, gerado pelo host). Retorna false para
+// frases com palavra repetida.
+bool generate_phrase(ulong rank, uint *phrase) {
+    return job_unrank(rank, phrase);
+}
+
+// Enumeração e filtros baratos: gera a frase do rank e diz se ela precisa
+// do PBKDF2. Frases com palavra repetida ou checksum BIP39 inválido (15 em
+// 16) param aqui. stages[0] e stages[1] (STATUS_DISTINCT e STATUS_ACCEPTED)
+// contam as que passam de cada filtro.
+bool accept_phrase(ulong rank, uint *phrase, uint *stages) {
+    if (!generate_phrase(rank, phrase)) {
+        return false;
+    }
+    stages[0]++;
+
+#if JOB_CHECKSUM
+    if (!job_checksum_ok(phrase)) {
+        return false;
+    }
+#endif
+    stages[1]++;
+    return true;
+}
+
+// Soma os contadores por estágio de cada work-item (STAGE_COUNTERS, a partir
+// de STATUS_DISTINCT) na memória local e leva o total do grupo ao buffer de
+// estado com uma atomic global por contador. Chamada pelo grupo inteiro, no
+// fim do kernel; group_stages tem STAGE_COUNTERS uints locais.
+void count_stages_group(const uint *stages, volatile __global uint* status,
+                        __local uint* group_stages) {
+    if (get_local_id(0) == 0) {
+        for (int i = 0; i < STAGE_COUNTERS; i++) {
+            group_stages[i] = 0;
+        }
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for (int i = 0; i < STAGE_COUNTERS; i++) {
+        if (stages[i]) {
+            atomic_add(&group_stages[i], stages[i]);
+        }
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (get_local_id(0) == 0) {
+        for (int i = 0; i < STAGE_COUNTERS; i++) {
+            if (group_stages[i]) {
+                atomic_add(&status[STATUS_DISTINCT + i], group_stages[i]);
+            }
+        }
+    }
+}
+
+// Tipos de script `scripts` (constante em cada LEAF de JOB_DERIVATION) de
+// uma chave do job comparados com os alvos (JOB_MATCH_*, do cabeçalho). A
+// chave pública é calculada uma vez para todos os tipos. Todos os work-items
+// do grupo chamam (point_mul_xy_group e o P2TR têm barreiras).
+bool match_key_group(const uint *key, uint scripts, bool active,
+                     __local uint* ec_tree, __global const uint* ec_table) {
+    uint x[8], y[8];
+    point_mul_xy_group(x, y, key, active, ec_tree, ec_table);
+
+    bool hit = false;
+    if (active && (scripts & (SCRIPT_P2PKH | SCRIPT_P2WPKH | SCRIPT_P2SH_P2WPKH))) {
+        uint hash160[5];
+        hash160_pubkey(x, y, hash160);
+        if ((scripts & SCRIPT_P2PKH) && JOB_MATCH_P2PKH(hash160)) {
+            hit = true;
+        }
+        if ((scripts & SCRIPT_P2WPKH) && JOB_MATCH_P2WPKH(hash160)) {
+            hit = true;
+        }
+        if (scripts & SCRIPT_P2SH_P2WPKH) {
+            uint script_hash[5];
+            hash160_p2wpkh_script(hash160, script_hash);
+            if (JOB_MATCH_P2SH_P2WPKH(script_hash)) {
+                hit = true;
+            }
+        }
+    }
+    if (scripts & SCRIPT_P2TR) {
+        uint qx[8];
+        taproot_output_x_group(x, y, qx, active, ec_tree, ec_table);
+        if (active && JOB_MATCH_P2TR(qx)) {
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+// Janela de endereços de uma conta (JOB_GAP > 0): conta/0/i e conta/1/i,
+// i < JOB_GAP. A chave pública de cada cadeia é calculada uma vez e serve
+// ao CKDpriv de todos os filhos, então cada índice custa um HMAC-SHA512 e
+// a chave pública do filho. O laço tem o mesmo número de voltas no grupo
+// todo (barreiras de match_key_group).
+bool match_gap_group(const uint *account, const ulong *account_chain, uint scripts,
+                     bool active, __local uint* ec_tree, __global const uint* ec_table) {
+    bool hit = false;
+    for (uint change = 0; change < 2; change++) {
+        uint key[8];
+        ulong chain[4];
+        copy_eight(key, account);
+        for (int i = 0; i < 4; i++) {
+            chain[i] = account_chain[i];
+        }
+        bip32_derive_child_group(key, chain, change, active, ec_tree, ec_table);
+
+        uint x[8], y[8];
+        point_mul_xy_group(x, y, key, active, ec_tree, ec_table);
+        for (uint index = 0; index < JOB_GAP; index++) {
+            uint child[8];
+            ulong child_chain[4];
+            copy_eight(child, key);
+            for (int i = 0; i < 4; i++) {
+                child_chain[i] = chain[i];
+            }
+            if (active) {
+                bip32_ckd(child, child_chain, index, 0x02 | (y[0] & 1), x);
+            }
+            if (match_key_group(child, scripts, active, ec_tree, ec_table)) {
+                hit = true;
+            }
+        }
+    }
+    return hit;
+}
+
+// Acertos do grupo na fila: cada acerto pega uma posição num contador local
+// e um só work-item reserva as do grupo com uma atomic_add global, então a
+// fila não vira disputa mesmo com muitos acertos (alvos truncados). Chamada
+// pelo grupo inteiro; group_hits tem 2 uints locais.
+void push_hit_group(ulong rank, bool hit, volatile __global uint* status,
+                    __global ulong* hits, __local uint* group_hits) {
+    if (get_local_id(0) == 0) {
+        group_hits[0] = 0;
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    uint slot = 0;
+    if (hit) {
+        slot = atomic_inc(&group_hits[0]);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (group_hits[0] == 0) {
+        return;  // o caso comum: o grupo todo sai junto
+    }
+    if (get_local_id(0) == 0) {
+        group_hits[1] = atomic_add(&status[STATUS_HITS], group_hits[0]);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    const uint index = group_hits[1] + slot;
+    if (hit && index < HIT_QUEUE_SIZE) {
+        hits[index] = rank;
     }
 }
 
-// Função para calcular hash SHA512
-void calculate_hash(const ulong* input, ulong* output) {
-    ulong state[8] = {
-        0x6a09e667f3bcc908ul,
-        0xbb67ae8584caa73bul,
-        0x3c6ef372fe94f82bul,
-        0xa54ff53a5f1d36f1ul,
-        0x510e527fade682d1ul,
-        0x9b05688c2b3e6c1ful,
-        0x1f83d9abfb41bd6bul,
-        0x5be0cd19137e2179ul
-    };
-    
-    ulong w[80];
-    
-    // Copiar input para w
-    for(int i = 0; i < 16; i++) {
-        w[i] = input[i];
-    }
-    
-    // Expandir mensagem
-    for(int i = 16; i < 80; i++) {
-        w[i] = sigma1(w[i-2]) + w[i-7] + sigma0(w[i-15]) + w[i-16];
-    }
-    
-    // Comprimir
-    ulong a = state[0];
-    ulong b = state[1];
-    ulong c = state[2];
-    ulong d = state[3];
-    ulong e = state[4];
-    ulong f = state[5];
-    ulong g = state[6];
-    ulong h = state[7];
-    
-    for(int i = 0; i < 80; i++) {
-        ulong t1 = h + SIGMA1(e) + CH(e,f,g) + k[i] + w[i];
-        ulong t2 = SIGMA0(a) + MAJ(a,b,c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
-    }
-    
-    output[0] = state[0] + a;
-    output[1] = state[1] + b;
+// PBKDF2, chave mestra e os caminhos do job. Chamada pelo grupo inteiro: as
+// multiplicações escalares dividem uma inversão por grupo (ec_tree,
+// EC_GROUP_TREE_SIZE uints locais), então todos os work-items entram aqui e
+// os com active = false só acompanham as barreiras. ec_table é a tabela de
+// G (só lida com EC_FIXED_BASE). No modo passphrase o rank é o da
+// passphrase e dictionary é o dicionário dela (JOB_PASSPHRASE).
+void check_phrase(ulong rank, const uint *phrase, bool active,
+                  volatile __global uint* status, __global ulong* hits,
+                  __local uint* ec_tree, __local uint* group_hits,
+                  __global const uint* ec_table, __global const uint* dictionary) {
+    // Chave e chain code de cada profundidade da árvore de caminhos; o
+    // JOB_DERIVATION só usa índices constantes, então ficam em registradores
+    uint keys[JOB_PATH_DEPTH + 1][8];
+    ulong chains[JOB_PATH_DEPTH + 1][4];
+    for (int i = 0; i < 8; i++) {
+        keys[0][i] = 0;
+    }
+    for (int i = 0; i < 4; i++) {
+        chains[0][i] = 0;
+    }
+    if (active) {
+        // Gerar seed a partir da frase (ou da passphrase do rank)
+        ulong seed[8];
+#if JOB_PASSPHRASE
+        passphrase_to_seed(rank, dictionary, seed);
+#else
+        mnemonic_to_seed(phrase, seed);
+#endif
+
+        // Chave mestra, uma vez para todos os caminhos
+        bip32_master_key(seed, keys[0], chains[0]);
+    }
+
+    // Caminhos em árvore: cada prefixo comum é derivado uma vez
+    bool hit = false;
+#define JOB_STEP(depth, index)                                                 \
+    copy_eight(keys[depth], keys[(depth) - 1]);                                \
+    for (int i = 0; i < 4; i++) {                                              \
+        chains[depth][i] = chains[(depth) - 1][i];                             \
+    }                                                                          \
+    bip32_derive_child_group(keys[depth], chains[depth], index, active,        \
+                             ec_tree, ec_table);
+#if JOB_GAP
+#define JOB_LEAF(depth, scripts)                                               \
+    if (match_gap_group(keys[depth], chains[depth], scripts, active,           \
+                        ec_tree, ec_table)) {                                  \
+        hit = true;                                                            \
+    }
+#else
+#define JOB_LEAF(depth, scripts)                                               \
+    if (match_key_group(keys[depth], scripts, active, ec_tree, ec_table)) {    \
+        hit = true;                                                            \
+    }
+#endif
+    JOB_DERIVATION(JOB_STEP, JOB_LEAF)
+#undef JOB_STEP
+#undef JOB_LEAF
+
+    push_hit_group(rank, active && hit, status, hits, group_hits);
 }
 
-// Kernel principal
-__kernel void verify(__global const uint* fixed_words,
-                    __global ulong* result,
-                    __global uint* found_words) {
-    size_t id = get_global_id(0);
-    
-    // Gerar frase e salvar índices a cada 200.5 milhões de tentativas
-    if (id % 200500000 == 0) {
-        generate_phrase(id, found_words);
-        result[1] = 1;  // Sinalizar que há uma frase para mostrar
-    }
-    
-    // Gerar seed a partir da frase
-    ulong block[16] = {0};
-    generate_phrase(id, found_words);
-    
-    // Calcular hash
-    ulong hash[2];
-    calculate_hash(block, hash);
-    
-    // Verificar se encontramos o endereço
-    if (hash[0] == TARGET_HIGH && hash[1] == TARGET_LOW) {
-        result[0] = id;
-    }
-}
\ No newline at end of file
+// Estágio 1: as frases aprovadas por accept_phrase entram compactadas em
+// `candidates` (deslocamento em relação a rank_offset). Assim os work-items
+// do verify só recebem frases que precisam do PBKDF2, em vez de 1 lane útil
+// a cada 16 num mesmo warp.
+__kernel void filter(__global uint* candidates,
+                     volatile __global uint* status,
+                     const ulong rank_offset,
+                     const ulong rank_end) {
+    __local uint group_stages[STAGE_COUNTERS];
+    ulong rank = rank_offset + get_global_id(0);
+
+    // O último lote pode ser arredondado para cima pelo tamanho do grupo
+    // local; os work-items além do fim só acompanham count_stages_group
+    uint stages[STAGE_COUNTERS] = {0, 0, 0, 0};
+    uint phrase[PHRASE_LEN];
+    if (rank < rank_end && accept_phrase(rank, phrase, stages)) {
+        candidates[atomic_inc(&status[STATUS_COUNT])] = (uint)get_global_id(0);
+    }
+    count_stages_group(stages, status, group_stages);
+}
+
+// Estágio 2: PBKDF2, BIP32 e comparação para as frases aprovadas pelo filter.
+// Lançado com o mesmo tamanho do lote (grupos de até EC_GROUP_MAX_LOCAL);
+// grupos inteiros além do contador do filter saem logo, e no último grupo
+// parcial os work-items sem candidato acompanham as barreiras de
+// check_phrase.
+__kernel void verify(volatile __global uint* status,
+                     __global ulong* hits,
+                     __global const uint* candidates,
+                     const ulong rank_offset,
+                     __global const uint* ec_table,
+                     __global const uint* dictionary) {
+    __local uint ec_tree[EC_GROUP_TREE_SIZE];
+    __local uint group_hits[2];
+    __local uint group_stages[STAGE_COUNTERS];
+
+    const uint total = status[STATUS_COUNT];
+    if (get_group_id(0) * get_local_size(0) >= total) {
+        return;
+    }
+    const bool active = get_global_id(0) < total;
+
+    ulong rank = 0;
+    uint phrase[PHRASE_LEN];
+    if (active) {
+        rank = rank_offset + candidates[get_global_id(0)];
+        generate_phrase(rank, phrase);
+    }
+    check_phrase(rank, phrase, active, status, hits, ec_tree, group_hits, ec_table,
+                 dictionary);
+
+    // Distintas e aprovadas já foram contadas pelo filter
+    uint stages[STAGE_COUNTERS] = {0, 0, active ? 1 : 0, active ? JOB_KEYS : 0};
+    count_stages_group(stages, status, group_stages);
+}
+
+// Maior grupo local aceito por search_persistent (tamanho da fila local)
+#define PERSISTENT_MAX_LOCAL 256
+#if PERSISTENT_MAX_LOCAL > EC_GROUP_MAX_LOCAL
+#error "Grupo do modo persistente maior que a árvore de inv_mod_group"
+#endif
+
+// Modo persistente: a grade tem o tamanho da ocupação do device e cada grupo
+// pega blocos de get_local_size(0) ranks do contador global
+// status[STATUS_COUNT] até passar de rank_end ou até o host levantar `stop`.
+// As frases aprovadas vão para uma fila em memória local; o grupo só roda o
+// PBKDF2 com um grupo cheio de frases (ou no fim), então os work-items
+// trabalham juntos. Todo bloco pego é processado por inteiro: o host calcula
+// o que foi coberto a partir do valor final do contador.
+__kernel void search_persistent(volatile __global uint* status,
+                                __global ulong* hits,
+                                volatile __global const uint* stop,
+                                const ulong rank_begin,
+                                const ulong rank_end,
+                                __global const uint* ec_table,
+                                __global const uint* dictionary) {
+    __local ulong queue[2 * PERSISTENT_MAX_LOCAL];
+    __local uint ec_tree[EC_GROUP_TREE_SIZE];
+    __local uint group_hits[2];
+    __local uint group_stages[STAGE_COUNTERS];
+    __local uint queued;
+    __local ulong block;
+
+    const uint lid = get_local_id(0);
+    const uint size = get_local_size(0);
+    if (lid == 0) {
+        queued = 0;
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    // Contadores por estágio do work-item, somados ao estado só no fim
+    uint stages[STAGE_COUNTERS] = {0, 0, 0, 0};
+    bool more = true;
+    while (true) {
+        // Encher a fila com pelo menos um grupo de frases; `queued` e `block`
+        // só são lidos depois de uma barreira, então o laço é uniforme
+        while (more && queued < size) {
+            if (lid == 0) {
+                block = *stop ? rank_end
+                              : rank_begin + (ulong)atomic_inc(&status[STATUS_COUNT]) * size;
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            ulong first = block;
+            if (first >= rank_end) {
+                more = false;
+            } else {
+                ulong rank = first + lid;
+                uint phrase[PHRASE_LEN];
+                if (rank < rank_end && accept_phrase(rank, phrase, stages)) {
+                    queue[atomic_inc(&queued)] = rank;
+                }
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        uint count = min(queued, size);
+        if (count == 0) {
+            break;
+        }
+
+        // Cada work-item pega uma frase do fim da fila; o grupo todo entra
+        // em check_phrase para dividir a inversão das multiplicações escalares
+        const bool active = lid < count;
+        ulong rank = active ? queue[queued - 1 - lid] : 0;
+        uint phrase[PHRASE_LEN];
+        if (active) {
+            generate_phrase(rank, phrase);
+        }
+        check_phrase(rank, phrase, active, status, hits, ec_tree, group_hits, ec_table,
+                     dictionary);
+        if (active) {
+            stages[2]++;
+            stages[3] += JOB_KEYS;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+        if (lid == 0) {
+            queued -= count;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    count_stages_group(stages, status, group_stages);
+}
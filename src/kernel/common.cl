@@ -1,13 +1,17 @@
 #ifndef COMMON_CL
 #define COMMON_CL
 
+// Definições de tipos
+typedef unsigned int uint32_t;
+typedef unsigned long uint64_t;
+
 // Macros para operações SHA512
 #define CH(x,y,z) ((x & y) ^ (~x & z))
 #define MAJ(x,y,z) ((x & y) ^ (x & z) ^ (y & z))
-#define SIGMA0(x) (rotate(x, 28UL) ^ rotate(x, 34UL) ^ rotate(x, 39UL))
-#define SIGMA1(x) (rotate(x, 14UL) ^ rotate(x, 18UL) ^ rotate(x, 41UL))
-#define sigma0(x) (rotate(x, 1UL) ^ rotate(x, 8UL) ^ (x >> 7))
-#define sigma1(x) (rotate(x, 19UL) ^ rotate(x, 61UL) ^ (x >> 6))
+#define SIGMA0(x) (ROTR64(x, 28) ^ ROTR64(x, 34) ^ ROTR64(x, 39))
+#define SIGMA1(x) (ROTR64(x, 14) ^ ROTR64(x, 18) ^ ROTR64(x, 41))
+#define sigma0(x) (ROTR64(x, 1) ^ ROTR64(x, 8) ^ (x >> 7))
+#define sigma1(x) (ROTR64(x, 19) ^ ROTR64(x, 61) ^ (x >> 6))
 
 // Rotações e shifts
 #define ROTR64(x,n) ((x >> n) | (x << (64 - n)))
@@ -16,6 +16,11 @@
   SECP256K1_P0, SECP256K1_P1, SECP256K1_P2, SECP256K1_P3, SECP256K1_P4,        \
       SECP256K1_P5, SECP256K1_P6, SECP256K1_P7
 
+// Ordem n do grupo (limbs little-endian)
+#define SECP256K1_N_VALUES                                                     \
+  0xd0364141, 0xbfd25e8c, 0xaf48a03b, 0xbaaedce6, 0xfffffffe, 0xffffffff,      \
+      0xffffffff, 0xffffffff
+
 __constant uint secpk256PreComputed[96] = {
     0x16f81798, 0x59f2815b, 0x2dce28d9, 0x029bfcdb, 0xce870b07, 0x55a06295,
     0xf9dcbbac, 0x79be667e, 0xfb10d4b8, 0x9c47d08f, 0xa6855419, 0xfd17b448,
@@ -190,6 +195,15 @@ inline void add_mod(uint *r, const uint *a, const uint *b) {
   sub(r, r, t);
 }
 
+// r = (a + b) mod n, usado na derivação BIP32 (IL + chave do pai)
+inline void add_mod_n(uint *r, const uint *a, const uint *b) {
+  uint n[8] = {SECP256K1_N_VALUES};
+  uint c = add(r, a, b);
+  if (c || !is_less(r, n)) {
+    sub(r, r, n);
+  }
+}
+
 void mul_mod(uint *r, const uint *a, const uint *b) {
   uint t[16] = {0};
   uint t0 = 0;
@@ -320,9 +334,9 @@ void point_double(uint *x, uint *y, uint *z) {
   copy_eight(z, t3);
 }
 
-void point_add(uint *x1, uint *y1, uint *z1, __constant uint *x2,
-               __constant uint *y2) // z2 = 1
-{
+// Soma mista (z2 = 1) com o ponto afim (x2, y2) em memória privada
+void point_add_xy(uint *x1, uint *y1, uint *z1, const uint *x2,
+                  const uint *y2) {
 
   uint t1[8];
   uint t2[8];
@@ -381,24 +395,20 @@ void point_add(uint *x1, uint *y1, uint *z1, __constant uint *x2,
   copy_eight(z1, t8);
 }
 
-uint msb_point(uint *n) {
-  uint msb = 256;
-  for (int i = 8; i >= 0; i--) {
-    if (n[i]) {
-      msb = i * 32 + 31 - __builtin_clz(n[i]);
-      break;
-    }
-  }
-  return msb;
+void point_add(uint *x1, uint *y1, uint *z1, __constant uint *x2,
+               __constant uint *y2) // z2 = 1
+{
+  uint x[8], y[8];
+  copy_eight(x, x2);
+  copy_eight(y, y2);
+  point_add_xy(x1, y1, z1, x, y);
 }
+
 int convert_to_window_naf(uint *naf, const uint *k) {
   int loop_start = 0;
   uint n[9] = {0, k[7], k[6], k[5], k[4], k[3], k[2], k[1], k[0]};
 
-  // Encontre o MSB do número (último bit relevante)
-  uint msb = msb_point(n);
-
-  for (int i = 0; i <= msb; i++) {
+  for (int i = 0; i <= 256; i++) {
     if (n[8] & 1) {
       int diff = n[8] & 0x0f;
       int val = diff;
@@ -438,7 +448,8 @@ int convert_to_window_naf(uint *naf, const uint *k) {
   return loop_start;
 }
 
-void point_mul_xy(uint *x1, uint *y1, const uint *k) {
+// k * G em coordenadas jacobianas (z1 ainda não invertido)
+void point_mul_jacobian(uint *x1, uint *y1, uint *z1, const uint *k) {
   uint naf[SECP256K1_NAF_SIZE] = {0};
   int loop_start = convert_to_window_naf(naf, k);
   const uint multiplier =
@@ -451,7 +462,10 @@ void point_mul_xy(uint *x1, uint *y1, const uint *k) {
 
   copy_eight(x1, secpk256PreComputed + x_pos);
   copy_eight(y1, secpk256PreComputed + y_pos);
-  uint z1[8] = {1, 0, 0, 0, 0, 0, 0, 0};
+  z1[0] = 1;
+  for (int i = 1; i < 8; i++) {
+    z1[i] = 0;
+  }
 
   for (int pos = loop_start - 1; pos >= 0; pos--) {
     point_double(x1, y1, z1);
@@ -465,12 +479,478 @@ void point_mul_xy(uint *x1, uint *y1, const uint *k) {
                 secpk256PreComputed + y_pos);
     }
   }
-  inv_mod(z1);
-  uint z2[8];
-  mul_mod(z2, z1, z1);
+}
+
+// Jacobiano -> afim, com zinv = z^-1 já calculado
+void point_to_affine(uint *x1, uint *y1, const uint *zinv) {
+  uint z2[8], z3[8];
+  mul_mod(z2, zinv, zinv);
   mul_mod(x1, x1, z2);
-  mul_mod(z1, z2, z1);
-  mul_mod(y1, y1, z1);
+  mul_mod(z3, z2, zinv);
+  mul_mod(y1, y1, z3);
+}
+
+void point_mul_xy(uint *x1, uint *y1, const uint *k) {
+  uint z1[8];
+  point_mul_jacobian(x1, y1, z1, k);
+  inv_mod(z1);
+  point_to_affine(x1, y1, z1);
+}
+
+// --- k * P com P variável: endomorfismo GLV ---
+// Na secp256k1, λ * (x, y) = (β * x, y). k = k1 + k2 * λ (mod n) com |k1| e
+// |k2| de ~128 bits, e os dois wNAF (janela GLV_WINDOW) entram num só laço de
+// dobramentos: ~129 em vez de ~256. As tabelas de P e de λ * P têm os
+// múltiplos ímpares P, 3P, ..., 15P; a de λ * P sai da de P com um mul_mod
+// por entrada. Constantes da decomposição como na libsecp256k1.
+
+#define GLV_WINDOW 5
+#define GLV_TABLE_SIZE (1 << (GLV_WINDOW - 2))
+#define GLV_NAF_SIZE 132
+
+#define SECP256K1_BETA_VALUES                                                  \
+  0x719501ee, 0xc1396c28, 0x12f58995, 0x9cf04975, 0xac3434e9, 0x6e64479e,      \
+      0x657c0710, 0x7ae96a2b
+
+// n - λ
+#define SECP256K1_MINUS_LAMBDA_VALUES                                          \
+  0xb51283cf, 0xe0cfc810, 0x8ec739c2, 0xa880b9fc, 0x77ed9ba4, 0x5ad9e3fd,      \
+      0x3fa3cf1f, 0xac9c52b3
+
+// -b1 e -b2 mod n da base reduzida do reticulado
+#define SECP256K1_MINUS_B1_VALUES                                              \
+  0x0abfe4c3, 0x6f547fa9, 0x010e8828, 0xe4437ed6, 0, 0, 0, 0
+#define SECP256K1_MINUS_B2_VALUES                                              \
+  0x3db1562c, 0xd765cda8, 0x0774346d, 0x8a280ac5, 0xfffffffe, 0xffffffff,      \
+      0xffffffff, 0xffffffff
+
+// round(2^384 * b2 / n) e round(2^384 * (-b1) / n)
+#define SECP256K1_G1_VALUES                                                    \
+  0x45dbb031, 0xe893209a, 0x71e8ca7f, 0x3daa8a14, 0x9284eb15, 0xe86c90e4,      \
+      0xa7d46bcd, 0x3086d221
+#define SECP256K1_G2_VALUES                                                    \
+  0x8ac47f71, 0x1571b4ae, 0x9df506c6, 0x221208ac, 0x0abfe4c4, 0x6f547fa9,      \
+      0x010e8828, 0xe4437ed6
+
+// (n - 1) / 2
+#define SECP256K1_N_HALF_VALUES                                                \
+  0x681b20a0, 0xdfe92f46, 0x57a4501d, 0x5d576e73, 0xffffffff, 0xffffffff,      \
+      0xffffffff, 0x7fffffff
+
+// 2^256 - n (129 bits)
+#define SECP256K1_N_C_VALUES                                                   \
+  0x2fc9bebf, 0x402da173, 0x50b75fc4, 0x45512319, 0x00000001
+
+// t[0..16) = a * b, sem redução
+void mul_wide(uint *t, const uint *a, const uint *b) {
+  for (int i = 0; i < 16; i++) {
+    t[i] = 0;
+  }
+  for (int i = 0; i < 8; i++) {
+    ulong carry = 0;
+    for (int j = 0; j < 8; j++) {
+      ulong p = (ulong)a[i] * b[j] + t[i + j] + carry;
+      t[i + j] = (uint)p;
+      carry = p >> 32;
+    }
+    t[i + 8] = (uint)carry;
+  }
+}
+
+// r[0..len) = lo (8 limbs) + hi[0..hlen) * (2^256 - n): o mesmo valor mod n,
+// com hlen limbs a menos de 2^256 na parte alta. len precisa caber o resultado.
+void fold_mod_n(uint *r, int len, const uint *lo, const uint *hi, int hlen) {
+  const uint c[5] = {SECP256K1_N_C_VALUES};
+  for (int i = 0; i < len; i++) {
+    r[i] = i < 8 ? lo[i] : 0;
+  }
+  for (int i = 0; i < hlen; i++) {
+    ulong carry = 0;
+    for (int j = 0; j < 5; j++) {
+      ulong p = (ulong)hi[i] * c[j] + r[i + j] + carry;
+      r[i + j] = (uint)p;
+      carry = p >> 32;
+    }
+    for (int j = i + 5; j < len && carry; j++) {
+      ulong s = (ulong)r[j] + carry;
+      r[j] = (uint)s;
+      carry = s >> 32;
+    }
+  }
+}
+
+// r = (a * b) mod n; r pode ser a ou b
+void mul_mod_n(uint *r, const uint *a, const uint *b) {
+  uint t[16], m1[13], m2[10], m3[9];
+  mul_wide(t, a, b);
+  fold_mod_n(m1, 13, t, t + 8, 8);   // < 2^386
+  fold_mod_n(m2, 10, m1, m1 + 8, 5); // < 2^290
+  fold_mod_n(m3, 9, m2, m2 + 8, 2);  // < 2^256 + 2^194 < 2n
+  uint n[8] = {SECP256K1_N_VALUES};
+  if (m3[8] || !is_less(m3, n)) {
+    sub(m3, m3, n);
+  }
+  copy_eight(r, m3);
+}
+
+// r = round(k * g / 2^384) (até 129 bits)
+void mul_shift_384(uint *r, const uint *k, const uint *g) {
+  uint t[16];
+  mul_wide(t, k, g);
+  uint c = t[11] >> 31;
+  for (int i = 0; i < 4; i++) {
+    ulong s = (ulong)t[12 + i] + c;
+    r[i] = (uint)s;
+    c = (uint)(s >> 32);
+  }
+  r[4] = c;
+  r[5] = r[6] = r[7] = 0;
+}
+
+// k = k1 + k2 * λ (mod n), com k1 e k2 "pequenos" a menos do sinal (mod n)
+void glv_split(uint *k1, uint *k2, const uint *k) {
+  const uint g1[8] = {SECP256K1_G1_VALUES};
+  const uint g2[8] = {SECP256K1_G2_VALUES};
+  const uint minus_b1[8] = {SECP256K1_MINUS_B1_VALUES};
+  const uint minus_b2[8] = {SECP256K1_MINUS_B2_VALUES};
+  const uint minus_lambda[8] = {SECP256K1_MINUS_LAMBDA_VALUES};
+  uint c1[8], c2[8];
+
+  mul_shift_384(c1, k, g1);
+  mul_shift_384(c2, k, g2);
+  mul_mod_n(c1, c1, minus_b1);
+  mul_mod_n(c2, c2, minus_b2);
+  add_mod_n(k2, c1, c2);
+  mul_mod_n(k1, k2, minus_lambda);
+  add_mod_n(k1, k1, k);
+}
+
+// Metade da decomposição em módulo e sinal: k > n/2 vira n - k (true)
+bool glv_abs(uint *k) {
+  const uint half[8] = {SECP256K1_N_HALF_VALUES};
+  if (is_greater(k, half)) {
+    uint n[8] = {SECP256K1_N_VALUES};
+    sub(k, n, k);
+    return true;
+  }
+  return false;
+}
+
+// wNAF de k (destruído) com dígitos ímpares em [-15, 15], um por posição;
+// retorna quantas posições são usadas
+int glv_wnaf(char *naf, uint *k) {
+  int len = 0;
+  for (int i = 0; i < GLV_NAF_SIZE; i++) {
+    naf[i] = 0;
+  }
+  for (int i = 0; i < GLV_NAF_SIZE; i++) {
+    if (!(k[0] | k[1] | k[2] | k[3] | k[4] | k[5] | k[6] | k[7])) {
+      break;
+    }
+    if (k[0] & 1) {
+      int d = k[0] & ((1 << GLV_WINDOW) - 1);
+      if (d >= (1 << (GLV_WINDOW - 1))) {
+        d -= 1 << GLV_WINDOW;
+      }
+      naf[i] = (char)d;
+      uint t[8] = {0};
+      if (d > 0) {
+        t[0] = d;
+        sub(k, k, t);
+      } else {
+        t[0] = -d;
+        add(k, k, t);
+      }
+      len = i + 1;
+    }
+    shift_first(k, k[7] >> 1);
+  }
+  return len;
+}
+
+// Soma jacobiana geral (x1, y1, z1) += (x2, y2, z2). Pontos iguais caem no
+// dobramento; retorna false se a soma é o infinito (pontos opostos).
+bool point_add_jac(uint *x1, uint *y1, uint *z1, const uint *x2,
+                   const uint *y2, const uint *z2) {
+  uint u1[8], u2[8], s1[8], s2[8], h[8], r[8], t[8];
+
+  mul_mod(t, z2, z2);
+  mul_mod(u1, x1, t);
+  mul_mod(t, t, z2);
+  mul_mod(s1, y1, t);
+  mul_mod(t, z1, z1);
+  mul_mod(u2, x2, t);
+  mul_mod(t, t, z1);
+  mul_mod(s2, y2, t);
+
+  sub_mod(h, u2, u1);
+  sub_mod(r, s2, s1);
+  const uint zero[8] = {0};
+  if (arrays_equal(h, zero)) {
+    if (!arrays_equal(r, zero)) {
+      return false;
+    }
+    point_double(x1, y1, z1);
+    return true;
+  }
+
+  mul_mod(z1, z1, z2);
+  mul_mod(z1, z1, h);
+
+  mul_mod(t, h, h);   // h^2
+  mul_mod(u1, u1, t); // u1 * h^2
+  mul_mod(t, t, h);   // h^3
+  mul_mod(s1, s1, t); // s1 * h^3
+
+  mul_mod(x1, r, r);
+  sub_mod(x1, x1, t);
+  sub_mod(x1, x1, u1);
+  sub_mod(x1, x1, u1);
+
+  sub_mod(y1, u1, x1);
+  mul_mod(y1, y1, r);
+  sub_mod(y1, y1, s1);
+  return true;
+}
+
+// Soma ao acumulador a entrada (ex, ey, ez) da tabela de P, levada a λ * P
+// (endo) e/ou negada. inf indica acumulador no infinito.
+void glv_add_entry(uint *x1, uint *y1, uint *z1, bool *inf, const uint *ex,
+                   const uint *ey, const uint *ez, bool negate, bool endo) {
+  uint x[8], y[8], z[8];
+  if (endo) {
+    const uint beta[8] = {SECP256K1_BETA_VALUES};
+    mul_mod(x, ex, beta);
+  } else {
+    copy_eight(x, ex);
+  }
+  if (negate) {
+    const uint p[8] = {SECPK256K_VALUES};
+    sub(y, p, ey);
+  } else {
+    copy_eight(y, ey);
+  }
+  copy_eight(z, ez);
+
+  if (*inf) {
+    copy_eight(x1, x);
+    copy_eight(y1, y);
+    copy_eight(z1, z);
+    *inf = false;
+  } else if (!point_add_jac(x1, y1, z1, x, y, z)) {
+    *inf = true;
+  }
+}
+
+// k * P em coordenadas jacobianas, com P = (px, py) afim e k em [1, n - 1]
+void point_mul_glv(uint *x1, uint *y1, uint *z1, const uint *px,
+                   const uint *py, const uint *k) {
+  uint k1[8], k2[8];
+  glv_split(k1, k2, k);
+  const bool neg1 = glv_abs(k1);
+  const bool neg2 = glv_abs(k2);
+
+  char naf1[GLV_NAF_SIZE], naf2[GLV_NAF_SIZE];
+  const int len1 = glv_wnaf(naf1, k1);
+  const int len2 = glv_wnaf(naf2, k2);
+
+  // P, 3P, ..., 15P
+  uint tx[GLV_TABLE_SIZE][8], ty[GLV_TABLE_SIZE][8], tz[GLV_TABLE_SIZE][8];
+  {
+    uint dx[8], dy[8], dz[8] = {1, 0, 0, 0, 0, 0, 0, 0};
+    copy_eight(dx, px);
+    copy_eight(dy, py);
+    point_double(dx, dy, dz);
+
+    copy_eight(tx[0], px);
+    copy_eight(ty[0], py);
+    for (int i = 0; i < 8; i++) {
+      tz[0][i] = i == 0;
+    }
+    for (int i = 1; i < GLV_TABLE_SIZE; i++) {
+      copy_eight(tx[i], tx[i - 1]);
+      copy_eight(ty[i], ty[i - 1]);
+      copy_eight(tz[i], tz[i - 1]);
+      point_add_jac(tx[i], ty[i], tz[i], dx, dy, dz);
+    }
+  }
+
+  bool inf = true;
+  for (int i = (len1 > len2 ? len1 : len2) - 1; i >= 0; i--) {
+    if (!inf) {
+      point_double(x1, y1, z1);
+    }
+    const int d1 = naf1[i];
+    if (d1) {
+      const int e = (d1 < 0 ? -d1 : d1) >> 1;
+      glv_add_entry(x1, y1, z1, &inf, tx[e], ty[e], tz[e], (d1 < 0) != neg1,
+                    false);
+    }
+    const int d2 = naf2[i];
+    if (d2) {
+      const int e = (d2 < 0 ? -d2 : d2) >> 1;
+      glv_add_entry(x1, y1, z1, &inf, tx[e], ty[e], tz[e], (d2 < 0) != neg2,
+                    true);
+    }
+  }
+}
+
+// k * P afim (GLV), para P variável
+void point_mul_xy_var(uint *x1, uint *y1, const uint *px, const uint *py,
+                      const uint *k) {
+  uint z1[8];
+  point_mul_glv(x1, y1, z1, px, py, k);
+  inv_mod(z1);
+  point_to_affine(x1, y1, z1);
+}
+
+// Tabela fixa de G em memória global (EcTable no host): para cada byte j da
+// chave e cada valor v de 1 a 255, o ponto afim v * 2^(8j) * G em 16 limbs
+// (x, y). k * G vira a soma de até 32 entradas, sem dobramentos. Como as
+// somas parciais ficam abaixo de 2^(8j) e cada entrada acima, nenhuma soma
+// cai no caso de pontos iguais ou opostos. Com EC_FIXED_BASE 0 (placas com
+// pouca memória) vale o wNAF com secpk256PreComputed.
+#ifndef EC_FIXED_BASE
+#define EC_FIXED_BASE 0
+#endif
+#define EC_TABLE_WINDOWS 32
+#define EC_TABLE_ENTRIES 255
+
+// k * G jacobiano: tabela fixa ou wNAF, conforme EC_FIXED_BASE
+void point_mul_g(uint *x1, uint *y1, uint *z1, const uint *k,
+                 __global const uint *table) {
+#if EC_FIXED_BASE
+  bool empty = true;
+  for (int j = 0; j < EC_TABLE_WINDOWS; j++) {
+    const uint v = (k[j >> 2] >> ((j & 3) * 8)) & 0xff;
+    if (v == 0) {
+      continue;
+    }
+
+    __global const uint *entry = table + (j * EC_TABLE_ENTRIES + v - 1) * 16;
+    uint x2[8], y2[8];
+    for (int i = 0; i < 8; i++) {
+      x2[i] = entry[i];
+      y2[i] = entry[8 + i];
+    }
+
+    if (empty) {
+      copy_eight(x1, x2);
+      copy_eight(y1, y2);
+      z1[0] = 1;
+      for (int i = 1; i < 8; i++) {
+        z1[i] = 0;
+      }
+      empty = false;
+    } else {
+      point_add_xy(x1, y1, z1, x2, y2);
+    }
+  }
+#else
+  point_mul_jacobian(x1, y1, z1, k);
+#endif
+}
+
+// Maior grupo local das funções *_group: a árvore de produtos tem até
+// 2 * EC_GROUP_MAX_LOCAL nós de 8 limbs em memória local
+#define EC_GROUP_MAX_LOCAL 256
+#define EC_GROUP_TREE_SIZE (2 * EC_GROUP_MAX_LOCAL * 8)
+
+// Inversão em lote (truque de Montgomery) no grupo de trabalho: sobe uma
+// árvore de produtos dos z em memória local, inverte só a raiz e desce
+// multiplicando o inverso de cada nó pelo irmão, então cada folha recebe o
+// inverso do seu z. São log2 níveis de mul_mod paralelos e um inv_mod por
+// grupo, em vez de um inv_mod por work-item. Todos os work-items do grupo
+// precisam chamar (há barreiras); quem não tem valor passa z = 1.
+void inv_mod_group(uint *z, __local uint *tree) {
+  const uint lid = get_local_id(0);
+  const uint size = get_local_size(0);
+  uint leaves = 1;
+  while (leaves < size) {
+    leaves <<= 1;
+  }
+
+  // Folhas em [leaves, 2 * leaves); as que sobram valem 1
+  for (int i = 0; i < 8; i++) {
+    tree[(leaves + lid) * 8 + i] = z[i];
+  }
+  if (size + lid < leaves) {
+    for (int i = 0; i < 8; i++) {
+      tree[(leaves + size + lid) * 8 + i] = (i == 0);
+    }
+  }
+  barrier(CLK_LOCAL_MEM_FENCE);
+
+  // Subida: nó n = nó 2n * nó 2n + 1
+  for (uint m = leaves >> 1; m > 0; m >>= 1) {
+    if (lid < m) {
+      const uint n = m + lid;
+      uint a[8], b[8], r[8];
+      for (int i = 0; i < 8; i++) {
+        a[i] = tree[2 * n * 8 + i];
+        b[i] = tree[(2 * n + 1) * 8 + i];
+      }
+      mul_mod(r, a, b);
+      for (int i = 0; i < 8; i++) {
+        tree[n * 8 + i] = r[i];
+      }
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+  }
+
+  if (lid == 0) {
+    uint root[8];
+    for (int i = 0; i < 8; i++) {
+      root[i] = tree[8 + i];
+    }
+    inv_mod(root);
+    for (int i = 0; i < 8; i++) {
+      tree[8 + i] = root[i];
+    }
+  }
+  barrier(CLK_LOCAL_MEM_FENCE);
+
+  // Descida: inverso do filho = inverso do pai * produto do irmão
+  for (uint m = 1; m < leaves; m <<= 1) {
+    if (lid < m) {
+      const uint n = m + lid;
+      uint inv[8], l[8], r[8], t[8];
+      for (int i = 0; i < 8; i++) {
+        inv[i] = tree[n * 8 + i];
+        l[i] = tree[2 * n * 8 + i];
+        r[i] = tree[(2 * n + 1) * 8 + i];
+      }
+      mul_mod(t, inv, r);
+      for (int i = 0; i < 8; i++) {
+        tree[2 * n * 8 + i] = t[i];
+      }
+      mul_mod(t, inv, l);
+      for (int i = 0; i < 8; i++) {
+        tree[(2 * n + 1) * 8 + i] = t[i];
+      }
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+  }
+
+  for (int i = 0; i < 8; i++) {
+    z[i] = tree[(leaves + lid) * 8 + i];
+  }
+  // A árvore pode ser reaproveitada logo em seguida
+  barrier(CLK_LOCAL_MEM_FENCE);
+}
+
+// point_mul_xy do grupo todo com uma inversão só (inv_mod_group). Todos os
+// work-items chamam; os com active = false só acompanham as barreiras.
+void point_mul_xy_group(uint *x1, uint *y1, const uint *k, bool active,
+                        __local uint *tree, __global const uint *table) {
+  uint z1[8] = {1, 0, 0, 0, 0, 0, 0, 0};
+  if (active) {
+    point_mul_g(x1, y1, z1, k, table);
+  }
+  inv_mod_group(z1, tree);
+  if (active) {
+    point_to_affine(x1, y1, z1);
+  }
 }
 
 #endif // EC_CL
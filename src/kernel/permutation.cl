@@ -0,0 +1,58 @@
+#ifndef PERMUTATION_CL
+#define PERMUTATION_CL
+
+// Enumeração exata de permutações parciais P(POOL_SIZE, PERM_LEN).
+// O rank é interpretado em ordem lexicográfica: o dígito do slot i vale
+// P(POOL_SIZE-1-i, PERM_LEN-1-i) e escolhe a i-ésima palavra ainda não
+// usada. A mesma conversão existe no host em permutation.hpp, então um rank
+// corresponde sempre à mesma frase nos dois lados.
+
+#ifndef POOL_SIZE
+#define POOL_SIZE 34
+#endif
+
+#ifndef PHRASE_LEN
+#define PHRASE_LEN 12
+#endif
+
+// Slots enumerados; com posições conhecidas é menor que PHRASE_LEN
+#ifndef PERM_LEN
+#define PERM_LEN PHRASE_LEN
+#endif
+
+// Converter rank em índices de palavras (0 <= rank < P(POOL_SIZE, PERM_LEN)).
+// Sem posições livres (PERM_LEN 0) o job não chama perm_unrank.
+#if PERM_LEN > 0
+void perm_unrank(ulong rank, uint *phrase) {
+    ulong place[PERM_LEN];
+    ulong value = 1;
+
+    // Valores posicionais, do último slot para o primeiro
+    for (int i = PERM_LEN - 1; i >= 0; i--) {
+        place[i] = value;
+        value *= (ulong)(POOL_SIZE - i);
+    }
+
+    ulong used = 0;
+    for (int i = 0; i < PERM_LEN; i++) {
+        uint digit = (uint)(rank / place[i]);
+        rank -= (ulong)digit * place[i];
+
+        // Selecionar a digit-ésima palavra livre
+        for (uint w = 0; w < POOL_SIZE; w++) {
+            if (used & (1UL << w)) {
+                continue;
+            }
+            if (digit == 0) {
+                phrase[i] = w;
+                used |= (1UL << w);
+                break;
+            }
+            digit--;
+        }
+    }
+}
+
+#endif // PERM_LEN > 0
+
+#endif // PERMUTATION_CL
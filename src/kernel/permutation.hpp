@@ -0,0 +1,143 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <string>
+
+// Versão host de permutation.cl: converte um rank de 64 bits em uma
+// permutação parcial de `length` palavras escolhidas de um pool de
+// `pool_size` palavras, em ordem lexicográfica. Cada rank em [0, total())
+// corresponde a exatamente uma frase, então qualquer intervalo de ranks pode
+// ser distribuído e retomado sem repetições nem lacunas.
+class PermutationRank {
+public:
+    static constexpr uint32_t MAX_POOL_SIZE = 64;  // máscara de palavras usadas em 64 bits
+
+    PermutationRank(uint32_t pool_size, uint32_t length)
+        : pool_size_(pool_size), length_(length), place_(length) {
+        if (length == 0 || length > pool_size || pool_size > MAX_POOL_SIZE) {
+            throw std::invalid_argument("Parâmetros de permutação inválidos: P(" +
+                                        std::to_string(pool_size) + ", " +
+                                        std::to_string(length) + ")");
+        }
+
+        // Valores posicionais, do último slot para o primeiro
+        uint64_t value = 1;
+        for (int i = static_cast<int>(length) - 1; i >= 0; i--) {
+            place_[i] = value;
+            uint64_t radix = pool_size - i;
+            if (value > UINT64_MAX / radix) {
+                throw std::overflow_error("Espaço de busca não cabe em 64 bits");
+            }
+            value *= radix;
+        }
+        total_ = value;
+    }
+
+    uint32_t pool_size() const { return pool_size_; }
+    uint32_t length() const { return length_; }
+
+    // Quantidade total de permutações: P(pool_size, length)
+    uint64_t total() const { return total_; }
+
+    // Converter rank em índices (mesmo algoritmo de perm_unrank no kernel)
+    void unrank(uint64_t rank, uint32_t* phrase) const {
+        if (rank >= total_) {
+            throw std::out_of_range("Rank fora do espaço de busca");
+        }
+
+        uint64_t used = 0;
+        for (uint32_t i = 0; i < length_; i++) {
+            uint32_t digit = static_cast<uint32_t>(rank / place_[i]);
+            rank -= digit * place_[i];
+
+            for (uint32_t w = 0; w < pool_size_; w++) {
+                if (used & (1ULL << w)) {
+                    continue;
+                }
+                if (digit == 0) {
+                    phrase[i] = w;
+                    used |= (1ULL << w);
+                    break;
+                }
+                digit--;
+            }
+        }
+    }
+
+    std::vector<uint32_t> unrank(uint64_t rank) const {
+        std::vector<uint32_t> phrase(length_);
+        unrank(rank, phrase.data());
+        return phrase;
+    }
+
+    // Operação inversa de unrank
+    uint64_t rank(const uint32_t* phrase) const {
+        uint64_t used = 0;
+        uint64_t result = 0;
+
+        for (uint32_t i = 0; i < length_; i++) {
+            uint32_t w = phrase[i];
+            if (w >= pool_size_ || (used & (1ULL << w))) {
+                throw std::invalid_argument("Frase não é uma permutação válida do pool");
+            }
+
+            // Dígito = quantidade de palavras livres menores que w
+            uint32_t digit = 0;
+            for (uint32_t j = 0; j < w; j++) {
+                if (!(used & (1ULL << j))) {
+                    digit++;
+                }
+            }
+
+            result += digit * place_[i];
+            used |= (1ULL << w);
+        }
+
+        return result;
+    }
+
+    // Avançar para a próxima permutação (rank + 1) sem refazer a conversão
+    // completa. Retorna false quando a frase já era a última do espaço.
+    bool next(uint32_t* phrase) const {
+        uint64_t used = 0;
+        for (uint32_t i = 0; i < length_; i++) {
+            used |= (1ULL << phrase[i]);
+        }
+
+        for (int i = static_cast<int>(length_) - 1; i >= 0; i--) {
+            used &= ~(1ULL << phrase[i]);
+
+            // Menor palavra livre maior que a atual neste slot
+            uint32_t w = phrase[i] + 1;
+            while (w < pool_size_ && (used & (1ULL << w))) {
+                w++;
+            }
+            if (w == pool_size_) {
+                continue;
+            }
+
+            phrase[i] = w;
+            used |= (1ULL << w);
+
+            // Preencher o restante com as menores palavras livres
+            uint32_t candidate = 0;
+            for (uint32_t j = i + 1; j < length_; j++) {
+                while (used & (1ULL << candidate)) {
+                    candidate++;
+                }
+                phrase[j] = candidate;
+                used |= (1ULL << candidate);
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    uint32_t pool_size_;
+    uint32_t length_;
+    uint64_t total_ = 0;
+    std::vector<uint64_t> place_;
+};
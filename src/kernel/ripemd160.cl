@@ -0,0 +1,104 @@
+#ifndef RIPEMD160_CL
+#define RIPEMD160_CL
+
+#include "common.cl"
+
+// RIPEMD-160 de um único bloco, usado no hash160 = RIPEMD160(SHA256(pubkey))
+
+#define RMD_F1(x, y, z) ((x) ^ (y) ^ (z))
+#define RMD_F2(x, y, z) (((x) & (y)) | (~(x) & (z)))
+#define RMD_F3(x, y, z) (((x) | ~(y)) ^ (z))
+#define RMD_F4(x, y, z) (((x) & (z)) | ((y) & ~(z)))
+#define RMD_F5(x, y, z) ((x) ^ ((y) | ~(z)))
+
+__constant uchar RMD_R[80] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+    3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+    1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+    4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13};
+
+__constant uchar RMD_RP[80] = {
+    5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+    6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+    15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+    8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+    12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11};
+
+__constant uchar RMD_S[80] = {
+    11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+    7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+    11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+    11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+    9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6};
+
+__constant uchar RMD_SP[80] = {
+    8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+    9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+    9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+    15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+    8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11};
+
+__constant uint RMD_K[5] = {0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc,
+                            0xa953fd4e};
+__constant uint RMD_KP[5] = {0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9,
+                             0x00000000};
+
+uint rmd_f(uint j, uint x, uint y, uint z) {
+    switch (j) {
+    case 0: return RMD_F1(x, y, z);
+    case 1: return RMD_F2(x, y, z);
+    case 2: return RMD_F3(x, y, z);
+    case 3: return RMD_F4(x, y, z);
+    default: return RMD_F5(x, y, z);
+    }
+}
+
+// Processar um bloco de 16 words little-endian
+void ripemd160_process(uint *state, const uint *X) {
+    uint al = state[0], bl = state[1], cl = state[2], dl = state[3], el = state[4];
+    uint ar = al, br = bl, cr = cl, dr = dl, er = el;
+    uint t;
+
+    for (uint j = 0; j < 80; j++) {
+        uint round = j >> 4;
+
+        t = rotate(al + rmd_f(round, bl, cl, dl) + X[RMD_R[j]] + RMD_K[round],
+                   (uint)RMD_S[j]) + el;
+        al = el; el = dl; dl = rotate(cl, 10U); cl = bl; bl = t;
+
+        t = rotate(ar + rmd_f(4 - round, br, cr, dr) + X[RMD_RP[j]] + RMD_KP[round],
+                   (uint)RMD_SP[j]) + er;
+        ar = er; er = dr; dr = rotate(cr, 10U); cr = br; br = t;
+    }
+
+    t = state[1] + cl + dr;
+    state[1] = state[2] + dl + er;
+    state[2] = state[3] + el + ar;
+    state[3] = state[4] + al + br;
+    state[4] = state[0] + bl + cr;
+    state[0] = t;
+}
+
+// RIPEMD-160 de um digest SHA-256 (8 words big-endian). O resultado fica em
+// 5 words little-endian, a mesma representação usada para o alvo no host.
+void ripemd160_32(const uint *digest, uint *out) {
+    uint X[16];
+    for (int i = 0; i < 8; i++) {
+        X[i] = swap32(digest[i]);
+    }
+    X[8] = 0x00000080;
+    for (int i = 9; i < 16; i++) {
+        X[i] = 0;
+    }
+    X[14] = 256;  // 32 bytes em bits
+
+    out[0] = 0x67452301;
+    out[1] = 0xefcdab89;
+    out[2] = 0x98badcfe;
+    out[3] = 0x10325476;
+    out[4] = 0xc3d2e1f0;
+    ripemd160_process(out, X);
+}
+
+#endif // RIPEMD160_CL
@@ -1,99 +1,172 @@
-#ifndef SHA256_CL
-#define SHA256_CL
-
-#define ROTR_256(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
-#define CH_SHA256(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
-#define MAJ_SHA256(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
-#define EP0_SHA256(x) (ROTR_256(x, 2) ^ ROTR_256(x, 13) ^ ROTR_256(x, 22))
-#define EP1_SHA256(x) (ROTR_256(x, 6) ^ ROTR_256(x, 11) ^ ROTR_256(x, 25))
-#define SIG0_SHA256(x) (ROTR_256(x, 7) ^ ROTR_256(x, 18) ^ ((x) >> 3))
-#define SIG1_SHA256(x) (ROTR_256(x, 17) ^ ROTR_256(x, 19) ^ ((x) >> 10))
-__constant uint K_256[64] = {
-    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
-    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
-    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
-    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
-    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
-    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
-    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
-    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
-#define H0 0x6a09e667
-#define H1 0xbb67ae85
-#define H2 0x3c6ef372
-#define H3 0xa54ff53a
-#define H4 0x510e527f
-#define H5 0x9b05688c
-#define H6 0x1f83d9ab
-#define H7 0x5be0cd19
-
-uchar sha256_from_byte(ulong max, ulong min) {
-
-  uint w[64] = {0};
-  uint a, b, c, d, e, f, g, h, temp1, temp2;
-
-  w[0] = (max >> 32) & 0xFFFFFFFF;
-  w[1] = max & 0xFFFFFFFF;
-  w[2] = (min >> 32) & 0xFFFFFFFF;
-  w[3] = min & 0xFFFFFFFF;
-  w[4] = 0x80000000;
-  w[15] = 128;
-
-#pragma unroll
-  for (int i = 16; i < 64; ++i) {
-    w[i] = w[i - 16] +
-           ((ROTR_256(w[i - 15], 7)) ^ (ROTR_256(w[i - 15], 18)) ^
-            (w[i - 15] >> 3)) +
-           w[i - 7] +
-           ((ROTR_256(w[i - 2], 17)) ^ (ROTR_256(w[i - 2], 19)) ^
-            (w[i - 2] >> 10));
-  }
-
-  a = H0;
-  b = H1;
-  c = H2;
-  d = H3;
-  e = H4;
-  f = H5;
-  g = H6;
-  h = H7;
-
-#pragma unroll
-  for (int i = 0; i < 63; ++i) {
-
-    temp1 = h + ((ROTR_256(e, 6)) ^ (ROTR_256(e, 11)) ^ (ROTR_256(e, 25))) +
-            ((e & f) ^ ((~e) & g)) + K_256[i] + w[i];
-    temp2 = ((ROTR_256(a, 2)) ^ (ROTR_256(a, 13)) ^ (ROTR_256(a, 22))) +
-            ((a & b) ^ (a & c) ^ (b & c));
-    h = g;
-    g = f;
-    f = e;
-    e = d + temp1;
-    d = c;
-    c = b;
-    b = a;
-    a = temp1 + temp2;
-  }
-
-  temp1 = (h + ((ROTR_256(e, 6)) ^ (ROTR_256(e, 11)) ^ (ROTR_256(e, 25))) +
-           ((e & f) ^ ((~e) & g)) + K_256[63] + w[63]);
-  temp2 = (((ROTR_256(a, 2)) ^ (ROTR_256(a, 13)) ^ (ROTR_256(a, 22))) +
-           ((a & b) ^ (a & c) ^ (b & c)));
-
-  a = temp1 + temp2;
-
-  return (uchar)(((H0 + a) >> 24) & 0xFF);
-}
-
-#undef H0
-#undef H1
-#undef H2
-#undef H3
-#undef H4
-#undef H5
-#undef H6
-#undef H7
-
-#endif // SHA256_CL
+#ifndef SHA256_CL
+#define SHA256_CL
+
+#define ROTR_256(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define CH_SHA256(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
+#define MAJ_SHA256(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define EP0_SHA256(x) (ROTR_256(x, 2) ^ ROTR_256(x, 13) ^ ROTR_256(x, 22))
+#define EP1_SHA256(x) (ROTR_256(x, 6) ^ ROTR_256(x, 11) ^ ROTR_256(x, 25))
+#define SIG0_SHA256(x) (ROTR_256(x, 7) ^ ROTR_256(x, 18) ^ ((x) >> 3))
+#define SIG1_SHA256(x) (ROTR_256(x, 17) ^ ROTR_256(x, 19) ^ ((x) >> 10))
+__constant uint K_256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+#define H0 0x6a09e667
+#define H1 0xbb67ae85
+#define H2 0x3c6ef372
+#define H3 0xa54ff53a
+#define H4 0x510e527f
+#define H5 0x9b05688c
+#define H6 0x1f83d9ab
+#define H7 0x5be0cd19
+
+uchar sha256_from_byte(ulong max, ulong min) {
+
+  uint w[64] = {0};
+  uint a, b, c, d, e, f, g, h, temp1, temp2;
+
+  w[0] = (max >> 32) & 0xFFFFFFFF;
+  w[1] = max & 0xFFFFFFFF;
+  w[2] = (min >> 32) & 0xFFFFFFFF;
+  w[3] = min & 0xFFFFFFFF;
+  w[4] = 0x80000000;
+  w[15] = 128;
+
+#pragma unroll
+  for (int i = 16; i < 64; ++i) {
+    w[i] = w[i - 16] +
+           ((ROTR_256(w[i - 15], 7)) ^ (ROTR_256(w[i - 15], 18)) ^
+            (w[i - 15] >> 3)) +
+           w[i - 7] +
+           ((ROTR_256(w[i - 2], 17)) ^ (ROTR_256(w[i - 2], 19)) ^
+            (w[i - 2] >> 10));
+  }
+
+  a = H0;
+  b = H1;
+  c = H2;
+  d = H3;
+  e = H4;
+  f = H5;
+  g = H6;
+  h = H7;
+
+#pragma unroll
+  for (int i = 0; i < 63; ++i) {
+
+    temp1 = h + ((ROTR_256(e, 6)) ^ (ROTR_256(e, 11)) ^ (ROTR_256(e, 25))) +
+            ((e & f) ^ ((~e) & g)) + K_256[i] + w[i];
+    temp2 = ((ROTR_256(a, 2)) ^ (ROTR_256(a, 13)) ^ (ROTR_256(a, 22))) +
+            ((a & b) ^ (a & c) ^ (b & c));
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+
+  temp1 = (h + ((ROTR_256(e, 6)) ^ (ROTR_256(e, 11)) ^ (ROTR_256(e, 25))) +
+           ((e & f) ^ ((~e) & g)) + K_256[63] + w[63]);
+  temp2 = (((ROTR_256(a, 2)) ^ (ROTR_256(a, 13)) ^ (ROTR_256(a, 22))) +
+           ((a & b) ^ (a & c) ^ (b & c)));
+
+  a = temp1 + temp2;
+
+  return (uchar)(((H0 + a) >> 24) & 0xFF);
+}
+
+// Compressão SHA-256 de um bloco de 16 words big-endian
+void sha256_process(uint *state, const uint *block) {
+  uint w[64];
+  uint a, b, c, d, e, f, g, h, temp1, temp2;
+
+  for (int i = 0; i < 16; ++i) {
+    w[i] = block[i];
+  }
+
+#pragma unroll
+  for (int i = 16; i < 64; ++i) {
+    w[i] = w[i - 16] + SIG0_SHA256(w[i - 15]) + w[i - 7] + SIG1_SHA256(w[i - 2]);
+  }
+
+  a = state[0];
+  b = state[1];
+  c = state[2];
+  d = state[3];
+  e = state[4];
+  f = state[5];
+  g = state[6];
+  h = state[7];
+
+#pragma unroll
+  for (int i = 0; i < 64; ++i) {
+    temp1 = h + EP1_SHA256(e) + CH_SHA256(e, f, g) + K_256[i] + w[i];
+    temp2 = EP0_SHA256(a) + MAJ_SHA256(a, b, c);
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+// SHA-256 da chave pública comprimida (prefixo 0x02/0x03 + x em 32 bytes).
+// x vem em 8 limbs little-endian, como em ec.cl.
+void sha256_pubkey(uint prefix, const uint *x, uint *digest) {
+  uint block[16];
+
+  block[0] = (prefix << 24) | (x[7] >> 8);
+  for (int i = 1; i < 8; ++i) {
+    block[i] = (x[8 - i] << 24) | (x[7 - i] >> 8);
+  }
+  block[8] = (x[0] << 24) | 0x00800000;
+  for (int i = 9; i < 15; ++i) {
+    block[i] = 0;
+  }
+  block[15] = 264;  // 33 bytes em bits
+
+  digest[0] = H0;
+  digest[1] = H1;
+  digest[2] = H2;
+  digest[3] = H3;
+  digest[4] = H4;
+  digest[5] = H5;
+  digest[6] = H6;
+  digest[7] = H7;
+  sha256_process(digest, block);
+}
+
+#undef H0
+#undef H1
+#undef H2
+#undef H3
+#undef H4
+#undef H5
+#undef H6
+#undef H7
+
+#endif // SHA256_CL
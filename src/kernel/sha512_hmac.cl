@@ -4,74 +4,253 @@
 #include "common.cl"
 
 // Constantes SHA512
-__constant uint64_t k[] = {
-    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL,
-    0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
-    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
-    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
-    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL,
-    0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
-    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL,
-    0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL
+__constant ulong SHA512_PRIMES[80] = {
+    0x428a2f98d728ae22UL, 0x7137449123ef65cdUL, 0xb5c0fbcfec4d3b2fUL,
+    0xe9b5dba58189dbbcUL, 0x3956c25bf348b538UL, 0x59f111f1b605d019UL,
+    0x923f82a4af194f9bUL, 0xab1c5ed5da6d8118UL, 0xd807aa98a3030242UL,
+    0x12835b0145706fbeUL, 0x243185be4ee4b28cUL, 0x550c7dc3d5ffb4e2UL,
+    0x72be5d74f27b896fUL, 0x80deb1fe3b1696b1UL, 0x9bdc06a725c71235UL,
+    0xc19bf174cf692694UL, 0xe49b69c19ef14ad2UL, 0xefbe4786384f25e3UL,
+    0x0fc19dc68b8cd5b5UL, 0x240ca1cc77ac9c65UL, 0x2de92c6f592b0275UL,
+    0x4a7484aa6ea6e483UL, 0x5cb0a9dcbd41fbd4UL, 0x76f988da831153b5UL,
+    0x983e5152ee66dfabUL, 0xa831c66d2db43210UL, 0xb00327c898fb213fUL,
+    0xbf597fc7beef0ee4UL, 0xc6e00bf33da88fc2UL, 0xd5a79147930aa725UL,
+    0x06ca6351e003826fUL, 0x142929670a0e6e70UL, 0x27b70a8546d22ffcUL,
+    0x2e1b21385c26c926UL, 0x4d2c6dfc5ac42aedUL, 0x53380d139d95b3dfUL,
+    0x650a73548baf63deUL, 0x766a0abb3c77b2a8UL, 0x81c2c92e47edaee6UL,
+    0x92722c851482353bUL, 0xa2bfe8a14cf10364UL, 0xa81a664bbc423001UL,
+    0xc24b8b70d0f89791UL, 0xc76c51a30654be30UL, 0xd192e819d6ef5218UL,
+    0xd69906245565a910UL, 0xf40e35855771202aUL, 0x106aa07032bbd1b8UL,
+    0x19a4c116b8d2d0c8UL, 0x1e376c085141ab53UL, 0x2748774cdf8eeb99UL,
+    0x34b0bcb5e19b48a8UL, 0x391c0cb3c5c95a63UL, 0x4ed8aa4ae3418acbUL,
+    0x5b9cca4f7763e373UL, 0x682e6ff3d6b2b8a3UL, 0x748f82ee5defb2fcUL,
+    0x78a5636f43172f60UL, 0x84c87814a1f0ab72UL, 0x8cc702081a6439ecUL,
+    0x90befffa23631e28UL, 0xa4506cebde82bde9UL, 0xbef9a3f7b2c67915UL,
+    0xc67178f2e372532bUL, 0xca273eceea26619cUL, 0xd186b8c721c0c207UL,
+    0xeada7dd6cde0eb1eUL, 0xf57d4f7fee6ed178UL, 0x06f067aa72176fbaUL,
+    0x0a637dc5a2c898a6UL, 0x113f9804bef90daeUL, 0x1b710b35131c471bUL,
+    0x28db77f523047d84UL, 0x32caab7b40c72493UL, 0x3c9ebe0a15c9bebcUL,
+    0x431d67c49c100d4cUL, 0x4cc5d4becb3e42b6UL, 0x597f299cfc657e2aUL,
+    0x5fcb6fab3ad6faecUL, 0x6c44198c4a475817UL
 };
 
-void sha512_init(uint64_t* state) {
-    state[0] = 0x6a09e667f3bcc908ULL;
-    state[1] = 0xbb67ae8584caa73bULL;
-    state[2] = 0x3c6ef372fe94f82bULL;
-    state[3] = 0xa54ff53a5f1d36f1ULL;
-    state[4] = 0x510e527fade682d1ULL;
-    state[5] = 0x9b05688c2b3e6c1fULL;
-    state[6] = 0x1f83d9abfb41bd6bULL;
-    state[7] = 0x5be0cd19137e2179ULL;
+// Definições e macros para SHA512
+#define F1(x, y, z) (bitselect(z, y, x))
+#define F0(x, y, z) (bitselect(x, y, ((x) ^ (z))))
+#define rotr64(a, n) (rotate((a), (64ul - n)))
+
+#define SHA512_S0(x) (rotr64(x, 28ul) ^ rotr64(x, 34ul) ^ rotr64(x, 39ul))
+#define SHA512_S1(x) (rotr64(x, 14ul) ^ rotr64(x, 18ul) ^ rotr64(x, 41ul))
+
+inline ulong L0(ulong x) {
+    return rotr64(x, 1ul) ^ rotr64(x, 8ul) ^ (x >> 7ul);
+}
+
+inline ulong L1(ulong x) {
+    return rotr64(x, 19ul) ^ rotr64(x, 61ul) ^ (x >> 6ul);
 }
 
-void sha512_update(uint64_t* state, const uint64_t* data, size_t len) {
-    uint64_t a = state[0];
-    uint64_t b = state[1];
-    uint64_t c = state[2];
-    uint64_t d = state[3];
-    uint64_t e = state[4];
-    uint64_t f = state[5];
-    uint64_t g = state[6];
-    uint64_t h = state[7];
-    uint64_t w[80];
-    
-    // Expandir mensagem
-    for(int i = 0; i < 16; i++) {
-        w[i] = data[i];
+#define COPY_EIGHT(a, b)                                                       \
+    (a)[0] = (b)[0], (a)[1] = (b)[1], (a)[2] = (b)[2], (a)[3] = (b)[3],          \
+    (a)[4] = (b)[4], (a)[5] = (b)[5], (a)[6] = (b)[6], (a)[7] = (b)[7];
+
+#define COPY_EIGHT_XOR(a, b)                                                   \
+    (a)[0] ^= (b)[0];                                                            \
+    (a)[1] ^= (b)[1];                                                            \
+    (a)[2] ^= (b)[2];                                                            \
+    (a)[3] ^= (b)[3];                                                            \
+    (a)[4] ^= (b)[4];                                                            \
+    (a)[5] ^= (b)[5];                                                            \
+    (a)[6] ^= (b)[6];                                                            \
+    (a)[7] ^= (b)[7];
+
+#define INIT_SHA512(a)                                                         \
+    (a)[0] = 0x6a09e667f3bcc908UL;                                               \
+    (a)[1] = 0xbb67ae8584caa73bUL;                                               \
+    (a)[2] = 0x3c6ef372fe94f82bUL;                                               \
+    (a)[3] = 0xa54ff53a5f1d36f1UL;                                               \
+    (a)[4] = 0x510e527fade682d1UL;                                               \
+    (a)[5] = 0x9b05688c2b3e6c1fUL;                                               \
+    (a)[6] = 0x1f83d9abfb41bd6bUL;                                               \
+    (a)[7] = 0x5be0cd19137e2179UL;
+
+#define IPAD 0x3636363636363636UL
+#define OPAD 0x5C5C5C5C5C5C5C5CUL
+
+// Macro para as operações de round
+#define RoR(a, b, c, d, e, f, g, h, x, K)                                      \
+    {                                                                          \
+        ulong t1 = K + SHA512_S1(e) + F1(e, f, g) + x;                         \
+        ulong t2 = SHA512_S0(a) + F0(a, b, c);                                 \
+        h += t1;                                                               \
+        d += h;                                                                \
+        h += t2;                                                               \
     }
-    
-    for(int i = 16; i < 80; i++) {
-        w[i] = sigma1(w[i-2]) + w[i-7] + sigma0(w[i-15]) + w[i-16];
+
+// 16 rounds consecutivos a partir da constante j
+#define SHA512_ROUND16(W, j)                                                   \
+    RoR(A0, A1, A2, A3, A4, A5, A6, A7, W[0], SHA512_PRIMES[j + 0]);           \
+    RoR(A7, A0, A1, A2, A3, A4, A5, A6, W[1], SHA512_PRIMES[j + 1]);           \
+    RoR(A6, A7, A0, A1, A2, A3, A4, A5, W[2], SHA512_PRIMES[j + 2]);           \
+    RoR(A5, A6, A7, A0, A1, A2, A3, A4, W[3], SHA512_PRIMES[j + 3]);           \
+    RoR(A4, A5, A6, A7, A0, A1, A2, A3, W[4], SHA512_PRIMES[j + 4]);           \
+    RoR(A3, A4, A5, A6, A7, A0, A1, A2, W[5], SHA512_PRIMES[j + 5]);           \
+    RoR(A2, A3, A4, A5, A6, A7, A0, A1, W[6], SHA512_PRIMES[j + 6]);           \
+    RoR(A1, A2, A3, A4, A5, A6, A7, A0, W[7], SHA512_PRIMES[j + 7]);           \
+    RoR(A0, A1, A2, A3, A4, A5, A6, A7, W[8], SHA512_PRIMES[j + 8]);           \
+    RoR(A7, A0, A1, A2, A3, A4, A5, A6, W[9], SHA512_PRIMES[j + 9]);           \
+    RoR(A6, A7, A0, A1, A2, A3, A4, A5, W[10], SHA512_PRIMES[j + 10]);         \
+    RoR(A5, A6, A7, A0, A1, A2, A3, A4, W[11], SHA512_PRIMES[j + 11]);         \
+    RoR(A4, A5, A6, A7, A0, A1, A2, A3, W[12], SHA512_PRIMES[j + 12]);         \
+    RoR(A3, A4, A5, A6, A7, A0, A1, A2, W[13], SHA512_PRIMES[j + 13]);         \
+    RoR(A2, A3, A4, A5, A6, A7, A0, A1, W[14], SHA512_PRIMES[j + 14]);         \
+    RoR(A1, A2, A3, A4, A5, A6, A7, A0, W[15], SHA512_PRIMES[j + 15]);
+
+// Expansão da mensagem no próprio buffer circular de 16 words
+#define SHA512_EXPAND(W, i)                                                    \
+    W[i] += L0(W[(i + 1) & 15]) + W[(i + 9) & 15] + L1(W[(i + 14) & 15]);
+
+#define SHA512_EXPAND16(W)                                                     \
+    SHA512_EXPAND(W, 0);  SHA512_EXPAND(W, 1);  SHA512_EXPAND(W, 2);           \
+    SHA512_EXPAND(W, 3);  SHA512_EXPAND(W, 4);  SHA512_EXPAND(W, 5);           \
+    SHA512_EXPAND(W, 6);  SHA512_EXPAND(W, 7);  SHA512_EXPAND(W, 8);           \
+    SHA512_EXPAND(W, 9);  SHA512_EXPAND(W, 10); SHA512_EXPAND(W, 11);          \
+    SHA512_EXPAND(W, 12); SHA512_EXPAND(W, 13); SHA512_EXPAND(W, 14);          \
+    SHA512_EXPAND(W, 15);
+
+// Compressão SHA-512 de um bloco de 16 words big-endian sobre o estado H.
+// W é o próprio buffer da expansão e sai destruído: quem monta o bloco
+// direto em W não paga uma segunda cópia de 16 words por compressão.
+void sha512_compress(ulong *W, ulong *H) {
+    ulong A0 = H[0], A1 = H[1], A2 = H[2], A3 = H[3], A4 = H[4],
+          A5 = H[5], A6 = H[6], A7 = H[7];
+
+    SHA512_ROUND16(W, 0);
+    SHA512_EXPAND16(W);
+    SHA512_ROUND16(W, 16);
+    SHA512_EXPAND16(W);
+    SHA512_ROUND16(W, 32);
+    SHA512_EXPAND16(W);
+    SHA512_ROUND16(W, 48);
+    SHA512_EXPAND16(W);
+    SHA512_ROUND16(W, 64);
+
+    H[0] += A0;
+    H[1] += A1;
+    H[2] += A2;
+    H[3] += A3;
+    H[4] += A4;
+    H[5] += A5;
+    H[6] += A6;
+    H[7] += A7;
+}
+
+// Bloco de um digest de 64 bytes depois de um bloco de 128 (todos os blocos
+// do laço do PBKDF2): M[0..7] e a constante 0x80.. seguida de zeros e do
+// comprimento (128 + 64) * 8 nas words 8..15. Somas K + W das words fixas e
+// termos constantes da expansão, calculados de antemão:
+#define SHA512_DIGEST_PAD 0x8000000000000000UL
+#define SHA512_DIGEST_LEN 1536UL
+#define SHA512_KW8 0x5807aa98a3030242UL        // K[8] + 0x80..
+#define SHA512_KW15 0xc19bf174cf692c94UL       // K[15] + 1536
+#define SHA512_L1_LEN 0x00c0000000003018UL     // L1(1536)
+#define SHA512_L0_PAD 0x4180000000000000UL     // L0(0x80..)
+#define SHA512_L0_LEN 0x000000000000030aUL     // L0(1536)
+
+// Compressão do bloco acima sobre o estado H: rounds 8..15 sem somar W, e a
+// primeira expansão (W[16..31]) sem os termos que valem zero
+void sha512_compress_digest(const ulong *M, ulong *H) {
+    ulong A0 = H[0], A1 = H[1], A2 = H[2], A3 = H[3], A4 = H[4],
+          A5 = H[5], A6 = H[6], A7 = H[7];
+    ulong W[16];
+
+    for (int i = 0; i < 8; i++) {
+        W[i] = M[i];
     }
-    
-    // Comprimir
-    for(int i = 0; i < 80; i++) {
-        uint64_t t1 = h + SIGMA1(e) + CH(e,f,g) + k[i] + w[i];
-        uint64_t t2 = SIGMA0(a) + MAJ(a,b,c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
+
+    RoR(A0, A1, A2, A3, A4, A5, A6, A7, W[0], SHA512_PRIMES[0]);
+    RoR(A7, A0, A1, A2, A3, A4, A5, A6, W[1], SHA512_PRIMES[1]);
+    RoR(A6, A7, A0, A1, A2, A3, A4, A5, W[2], SHA512_PRIMES[2]);
+    RoR(A5, A6, A7, A0, A1, A2, A3, A4, W[3], SHA512_PRIMES[3]);
+    RoR(A4, A5, A6, A7, A0, A1, A2, A3, W[4], SHA512_PRIMES[4]);
+    RoR(A3, A4, A5, A6, A7, A0, A1, A2, W[5], SHA512_PRIMES[5]);
+    RoR(A2, A3, A4, A5, A6, A7, A0, A1, W[6], SHA512_PRIMES[6]);
+    RoR(A1, A2, A3, A4, A5, A6, A7, A0, W[7], SHA512_PRIMES[7]);
+    RoR(A0, A1, A2, A3, A4, A5, A6, A7, 0, SHA512_KW8);
+    RoR(A7, A0, A1, A2, A3, A4, A5, A6, 0, SHA512_PRIMES[9]);
+    RoR(A6, A7, A0, A1, A2, A3, A4, A5, 0, SHA512_PRIMES[10]);
+    RoR(A5, A6, A7, A0, A1, A2, A3, A4, 0, SHA512_PRIMES[11]);
+    RoR(A4, A5, A6, A7, A0, A1, A2, A3, 0, SHA512_PRIMES[12]);
+    RoR(A3, A4, A5, A6, A7, A0, A1, A2, 0, SHA512_PRIMES[13]);
+    RoR(A2, A3, A4, A5, A6, A7, A0, A1, 0, SHA512_PRIMES[14]);
+    RoR(A1, A2, A3, A4, A5, A6, A7, A0, 0, SHA512_KW15);
+
+    // W[t] = W[t-16] + L0(W[t-15]) + W[t-7] + L1(W[t-2]) com W[9..14] = 0
+    W[0] = W[0] + L0(W[1]);
+    W[1] = W[1] + L0(W[2]) + SHA512_L1_LEN;
+    W[2] = W[2] + L0(W[3]) + L1(W[0]);
+    W[3] = W[3] + L0(W[4]) + L1(W[1]);
+    W[4] = W[4] + L0(W[5]) + L1(W[2]);
+    W[5] = W[5] + L0(W[6]) + L1(W[3]);
+    W[6] = W[6] + L0(W[7]) + SHA512_DIGEST_LEN + L1(W[4]);
+    W[7] = W[7] + SHA512_L0_PAD + W[0] + L1(W[5]);
+    W[8] = SHA512_DIGEST_PAD + W[1] + L1(W[6]);
+    W[9] = W[2] + L1(W[7]);
+    W[10] = W[3] + L1(W[8]);
+    W[11] = W[4] + L1(W[9]);
+    W[12] = W[5] + L1(W[10]);
+    W[13] = W[6] + L1(W[11]);
+    W[14] = SHA512_L0_LEN + W[7] + L1(W[12]);
+    W[15] = SHA512_DIGEST_LEN + L0(W[0]) + W[8] + L1(W[13]);
+
+    SHA512_ROUND16(W, 16);
+    SHA512_EXPAND16(W);
+    SHA512_ROUND16(W, 32);
+    SHA512_EXPAND16(W);
+    SHA512_ROUND16(W, 48);
+    SHA512_EXPAND16(W);
+    SHA512_ROUND16(W, 64);
+
+    H[0] += A0;
+    H[1] += A1;
+    H[2] += A2;
+    H[3] += A3;
+    H[4] += A4;
+    H[5] += A5;
+    H[6] += A6;
+    H[7] += A7;
+}
+
+// Compressão preservando a mensagem
+void sha512_procces(const ulong *message, ulong *H) {
+    ulong W[16];
+
+    for (int i = 0; i < 16; i++) {
+        W[i] = message[i];
     }
-    
-    state[0] += a;
-    state[1] += b;
-    state[2] += c;
-    state[3] += d;
-    state[4] += e;
-    state[5] += f;
-    state[6] += g;
-    state[7] += h;
+    sha512_compress(W, H);
 }
 
-void sha512_final(uint64_t* state) {
-    // Nada a fazer aqui, já que estamos processando blocos completos
+// HMAC-SHA512 com chave de até 128 bytes (key: 16 words com zeros à direita)
+// e mensagem de um único bloco já com padding. O comprimento no fim do bloco
+// deve contar os 128 bytes do bloco da chave.
+void hmac_sha512_block(const ulong *key, const ulong *message, ulong *out) {
+    ulong block[16];
+    ulong inner[8];
+
+    for (int i = 0; i < 16; i++) {
+        block[i] = key[i] ^ IPAD;
+    }
+    INIT_SHA512(inner);
+    sha512_procces(block, inner);
+    sha512_procces(message, inner);
+
+    for (int i = 0; i < 16; i++) {
+        block[i] = key[i] ^ OPAD;
+    }
+    INIT_SHA512(out);
+    sha512_procces(block, out);
+    sha512_compress_digest(inner, out);
 }
 
-#endif // SHA512_HMAC_CL 
\ No newline at end of file
+#endif // SHA512_HMAC_CL
@@ -1,7 +1,4 @@
-#define CL_HPP_ENABLE_EXCEPTIONS
-#define CL_HPP_TARGET_OPENCL_VERSION 200
-#define CL_HPP_MINIMUM_OPENCL_VERSION 200
-#include <CL/opencl.hpp>
+#include "opencl_manager.hpp"
 #include "globals.hpp"
 #include <iostream>
 #include <vector>
@@ -11,8 +8,22 @@
 #include <filesystem>
 #include <algorithm>
 #include <iomanip>  // para std::fixed e std::setprecision
+#include "address.hpp"
 #include "bitcoin_utils.hpp"
 #include "bip39_utils.hpp"
+#include "job_spec.hpp"
+#include "search_space.hpp"
+#include "passphrase_space.hpp"
+#include "work_scheduler.hpp"
+#include "dispatch_engine.hpp"
+#include "ec_table.hpp"
+#include "host_task_queue.hpp"
+#include "progress_journal.hpp"
+#include "telemetry.hpp"
+#include "autotuner.hpp"
+#include "search_program.hpp"
+#include "batch_sizer.hpp"
+#include "cpu/cpu_search.hpp"
 #include <sstream>
 // Incluir cabeçalhos específicos do sistema operacional para caminhos
 #ifdef _WIN32
@@ -23,6 +34,12 @@
 #endif
 #include <chrono>
 #include <set>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <csignal>
+#include <future>
 
 using namespace cl;  // Adicionar o namespace cl
 
@@ -125,317 +142,795 @@ void test_wallet() {
     }
 }
 
-int main() {
+// Parâmetros da busca compartilhados pelos workers de dispositivo
+struct SearchJob {
+    JobSpec spec;
+    const SearchSpace* space;
+    // Modo passphrase: o rank é o da passphrase, e o dicionário vai para as GPUs
+    const PassphraseSpace* passphrases = nullptr;
+    std::vector<uint32_t> dictionary;   // PassphraseSpace::kernel_dictionary
+    std::string kernel_header;   // JobSpec::kernel_header, gerado uma vez
+    std::vector<uint16_t> bip39_index;  // vazio sem filtro de checksum
+    bool persistent = true;      // kernel persistente nas GPUs (--no-persistent desliga)
+    bool ec_table = true;        // tabela fixa de G nas GPUs (--no-ec-table desliga)
+    TuningCache* tuning = nullptr;  // cache de ajuste das GPUs (--tuning)
+    bool autotune = false;       // calibrar as GPUs e gravar no cache (--autotune)
+    // Duração alvo de cada lançamento nas GPUs (--batch-ms; 0 = lotes fixos)
+    double batch_seconds = BatchSizer::DEFAULT_TARGET_SECONDS;
+    // Compilação adiantada do programa de cada GPU (prebuild), uma por dispositivo
+    std::vector<std::shared_future<void>> prebuilt;
+
+    uint64_t total() const { return passphrases ? passphrases->total() : space->total(); }
+};
+
+// Espera as compilações adiantadas de SearchJob::prebuilt ao sair do escopo,
+// inclusive por exceção. Elas usam os dispositivos e o cache de ajuste, então
+// o guard é declarado depois deles para ser destruído antes.
+struct PrebuildWait {
+    std::vector<std::shared_future<void>>& prebuilt;
+
+    ~PrebuildWait() {
+        for (auto& build : prebuilt) {
+            build.wait();
+        }
+    }
+};
+
+// Saída no console é compartilhada pelas threads
+std::mutex output_mutex;
+
+std::string phrase_from_indices(const SearchJob& job, const std::vector<uint32_t>& indices) {
+    std::string frase;
+    for (size_t i = 0; i < indices.size(); i++) {
+        if (i > 0) frase += " ";
+        frase += job.spec.words[indices[i]];
+    }
+    return frase;
+}
+
+// Confirmar no host com OpenSSL o rank reportado pelo device. O device só
+// informa a frase (ou a passphrase); aqui se descobre qual caminho e tipo de
+// script bateu.
+bool confirm_hit(const SearchJob& job, size_t device_id, uint64_t rank) {
+    std::string frase = job.passphrases ? job.spec.known_phrase()
+                                        : phrase_from_indices(job, job.space->unrank(rank));
+    std::string passphrase = job.passphrases ? job.passphrases->candidate(rank) : "";
+    auto seed = BIP39Utils::mnemonic_to_seed(frase, passphrase);
+
+    for (const auto& path : job.spec.paths) {
+        for (const auto& leaf : job.spec.leaf_paths(path)) {
+            auto private_key = BitcoinUtils::derive_private_key(seed, leaf);
+            for (uint32_t t = 0; t < Address::SCRIPT_TYPES; t++) {
+                const ScriptType script = static_cast<ScriptType>(t);
+                if (!(path.scripts & Address::bit(script))) {
+                    continue;
+                }
+                // Compara o valor decodificado (bech32 aceita maiúsculas no job)
+                std::string endereco = Address::from_private_key(private_key, script);
+                const auto program = Address::decode(endereco).program;
+                if (std::none_of(job.spec.targets.begin(), job.spec.targets.end(),
+                                 [&](const std::string& target) {
+                                     const AddressTarget decoded = Address::decode(target);
+                                     return decoded.script == script && decoded.program == program;
+                                 })) {
+                    continue;
+                }
+
+                std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << "\n=== FRASE ENCONTRADA! ===" << std::endl;
+                std::cout << "Frase: " << frase << std::endl;
+                if (job.passphrases) {
+                    std::cout << "Passphrase: " << passphrase << std::endl;
+                }
+                std::cout << "Endereço: " << endereco << " (" << Address::name(script) << ")"
+                          << std::endl;
+                std::cout << "Caminho: " << JobSpec::format_path(leaf) << std::endl;
+                std::cout << "WIF: " << BitcoinUtils::private_key_to_wif(private_key) << std::endl;
+                std::cout << "=======================" << std::endl;
+                return true;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(output_mutex);
+    std::cerr << "\nAVISO: acerto do device " << device_id
+              << " não confirmado no host (rank " << rank << ", " << frase
+              << (job.passphrases ? ", passphrase " + passphrase : "") << ")" << std::endl;
+    return false;
+}
+
+// Mostrar uma frase de amostra (índices na tabela de palavras do job) com a
+// passphrase dela
+void show_sample(const SearchJob& job, size_t device_id,
+                 const std::array<uint32_t, 12>& found_words,
+                 const std::string& passphrase = "") {
+    std::string frase;
+    std::set<std::string> palavras_usadas; // Para verificar repetições
+    bool tem_repeticao = false;
+
+    for (int i = 0; i < 12; i++) {
+        if (i > 0) frase += " ";
+        std::string palavra = job.spec.words[found_words[i]];
+        frase += palavra;
+        if (!palavras_usadas.insert(palavra).second) {
+            tem_repeticao = true;
+        }
+    }
+
+    // Gerar seed e chaves (primeira chave do primeiro caminho, primeiro tipo
+    // de script dele)
+    const auto& path = job.spec.paths.front();
+    ScriptType script = ScriptType::P2PKH;
+    for (uint32_t t = Address::SCRIPT_TYPES; t-- > 0;) {
+        if (path.scripts & (1u << t)) {
+            script = static_cast<ScriptType>(t);
+        }
+    }
+    auto seed = BIP39Utils::mnemonic_to_seed(frase, passphrase);
+    auto private_key = BitcoinUtils::derive_private_key(seed, job.spec.leaf_paths(path).front());
+    std::string wif = BitcoinUtils::private_key_to_wif(private_key);
+    std::string endereco = Address::from_private_key(private_key, script);
+
+    std::lock_guard<std::mutex> lock(output_mutex);
+    if (tem_repeticao) {
+        std::cout << "\nAVISO: Frase contém palavras repetidas!" << std::endl;
+    }
+    std::cout << "\n----------------------------------------" << std::endl;
+    std::cout << "Dispositivo " << device_id << std::endl;
+    std::cout << "Frase atual: " << frase << std::endl;
+    if (job.passphrases) {
+        std::cout << "Passphrase: " << passphrase << std::endl;
+    }
+    std::cout << "Endereço: " << endereco << std::endl;
+    std::cout << "WIF: " << wif << std::endl;
+    std::cout << "----------------------------------------\n" << std::endl;
+}
+
+// Amostras de um lote do device: os ranks múltiplos de SAMPLE_INTERVAL cuja
+// frase não repete palavra (a mesma regra do motor de CPU). No modo
+// passphrase a frase é a conhecida e o rank escolhe a passphrase.
+void post_samples(const SearchJob& job, size_t device_id, const RankRange& batch,
+                  HostTaskQueue& host_tasks) {
+    const uint64_t interval = CpuSearchEngine::SAMPLE_INTERVAL;
+    for (uint64_t rank = (batch.begin + interval - 1) / interval * interval;
+         rank < batch.end; rank += interval) {
+        if (job.passphrases) {
+            std::vector<uint32_t> indices = job.space->unrank(0);
+            std::array<uint32_t, 12> words;
+            std::copy(indices.begin(), indices.end(), words.begin());
+            std::string passphrase = job.passphrases->candidate(rank);
+            host_tasks.post([&job, device_id, words, passphrase]() {
+                show_sample(job, device_id, words, passphrase);
+            });
+            continue;
+        }
+        std::vector<uint32_t> indices = job.space->unrank(rank);
+        if (job.space->needs_distinct_check() && !job.space->distinct(indices.data())) {
+            continue;
+        }
+        std::array<uint32_t, 12> words;
+        std::copy(indices.begin(), indices.end(), words.begin());
+        host_tasks.post([&job, device_id, words]() { show_sample(job, device_id, words); });
+    }
+}
+
+// Configuração do cache de ajuste para este dispositivo, driver e kernels,
+// se houver e respeitar --no-persistent e --no-ec-table
+bool cached_config(const Device& device, const SearchJob& job, LaunchConfig& config) {
+    LaunchConfig cached;
+    double rate = 0.0;
+    if (!job.tuning ||
+        !job.tuning->find(TuningCache::key(device, job.kernel_header), cached, rate) ||
+        (!job.persistent && cached.persistent) || (!job.ec_table && cached.ec_table)) {
+        return false;
+    }
+    config = cached;
+    return true;
+}
+
+// Compilar as variantes do programa que o worker do dispositivo vai usar (a
+// do cache de ajuste ou a padrão; as duas para a calibração), gravando os
+// binários no cache. Roda durante o autoteste e a espera do Enter, então o
+// worker só carrega o binário.
+void prebuild(const Device& device, const SearchJob& job) {
+    std::vector<bool> variants;
+    if (job.tuning && job.autotune) {
+        variants = job.ec_table ? std::vector<bool>{true, false} : std::vector<bool>{false};
+    } else {
+        LaunchConfig config;
+        config.ec_table = job.ec_table;
+        cached_config(device, job, config);
+        variants = {config.ec_table};
+    }
+    for (bool table : variants) {
+        if (should_exit) {
+            return;
+        }
+        SearchProgram program(device, job.kernel_header, table, job.dictionary);
+    }
+}
+
+// Loop de busca de um dispositivo: pede lotes ao escalonador até acabar o
+// trabalho, encontrar o endereço ou o dispositivo falhar. Confirmações e
+// amostras vão para a fila do host; a thread só alimenta o dispositivo.
+void device_worker(size_t id, const Device& device, WorkScheduler& scheduler,
+                   CoverageMap& coverage, const SearchJob& job, HostTaskQueue& host_tasks,
+                   Telemetry* telemetry) {
+    try {
+        // Erros da compilação adiantada reaparecem na compilação abaixo
+        if (id < job.prebuilt.size()) {
+            job.prebuilt[id].wait();
+        }
+
+        // Configuração de lançamento: medida agora (--autotune), a do cache
+        // de ajuste ou a padrão
+        LaunchConfig config;
+        config.persistent = job.persistent;
+        config.ec_table = job.ec_table;
+        std::string source = "padrão";
+        if (job.tuning && job.autotune) {
+            {
+                std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << "Dispositivo " << id << ": calibrando "
+                          << OpenCLManager::describe(device) << std::endl;
+            }
+            double rate = 0.0;
+            Autotuner tuner(device, job.kernel_header, job.spec.checksum, job.total(),
+                            job.dictionary);
+            config = tuner.run(job.persistent, job.ec_table, rate,
+                               [id](const LaunchConfig& tried, double measured) {
+                std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << "  [" << id << "] " << tried.describe() << ": " << std::fixed
+                          << std::setprecision(0) << measured << " frases/s" << std::endl;
+            });
+            // Uma calibração interrompida não vai para o cache
+            if (!should_exit) {
+                job.tuning->store(TuningCache::key(device, job.kernel_header), config, rate);
+                source = "calibrada";
+            }
+        } else if (cached_config(device, job, config)) {
+            source = "do cache de ajuste";
+        }
+
+        SearchProgram program(device, job.kernel_header, config.ec_table, job.dictionary);
+        config = program.resolve(config, job.spec.checksum);
+        uint64_t max_batch;
+        std::unique_ptr<DispatchEngine> engine = program.engine(config, max_batch);
+        // Lotes pela duração de kernel medida; sem alvo, o lote do modo
+        // compactado ou o bloco inteiro do escalonador (persistente)
+        std::unique_ptr<BatchSizer> sizer;
+        if (job.batch_seconds > 0.0) {
+            sizer = std::make_unique<BatchSizer>(job.batch_seconds, program.min_batch(config),
+                                                 max_batch);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cout << "Dispositivo " << id << " pronto: "
+                      << OpenCLManager::describe(device) << " (" << config.describe()
+                      << (engine->persistent() && !engine->has_stop_flag()
+                              ? ", sem flag de parada" : "")
+                      << ", " << program.private_bytes(config.persistent)
+                      << " B privados/work-item; configuração " << source
+                      << (program.manager().binary_from_cache ? ", binário do cache" : "") << ")"
+                      << std::endl;
+        }
+
+        try {
+            engine->run(
+                [&](RankRange& batch) {
+                    return scheduler.next_batch(id, sizer ? sizer->next() : max_batch, batch);
+                },
+                [&](const BatchResult& result, double seconds) {
+                    scheduler.report(id, result.batch.size(), seconds);
+                    if (sizer) {
+                        sizer->report(result.batch.size(), result.kernel_seconds > 0.0
+                                                               ? result.kernel_seconds
+                                                               : seconds);
+                    }
+                    coverage.add(result.batch);
+                    // Lote persistente interrompido: o resto volta ao escalonador
+                    scheduler.release(result.remainder);
+                    if (telemetry) {
+                        telemetry->add(id, result.stages);
+                    }
+
+                    // Acertos do device (comparação truncada): confirmados
+                    // no pool do host
+                    for (uint64_t rank : result.hits) {
+                        host_tasks.post([&job, id, rank]() {
+                            if (confirm_hit(job, id, rank)) {
+                                found_address = true;
+                                should_exit = true;
+                            }
+                        });
+                    }
+                    if (result.hit_count > result.hits.size()) {
+                        std::lock_guard<std::mutex> lock(output_mutex);
+                        std::cerr << "\nAVISO: " << result.hit_count - result.hits.size()
+                                  << " acertos do dispositivo " << id
+                                  << " não couberam na fila (lote " << result.batch.begin
+                                  << "-" << result.batch.end << ")" << std::endl;
+                    }
+
+                    // Frases de amostra: o host sabe quais ranks do lote são amostras
+                    post_samples(job, id, result.batch, host_tasks);
+                });
+        } catch (...) {
+            // Lotes em voo não foram verificados: devolver ao escalonador
+            for (const auto& batch : engine->in_flight()) {
+                scheduler.release(batch);
+            }
+            throw;
+        }
+        return;
+
+    } catch (const Error& e) {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        std::cerr << "Erro OpenCL no dispositivo " << id << ": " << e.what()
+                  << " (código: " << e.err() << ")" << std::endl;
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        std::cerr << "Erro no dispositivo " << id << ": " << e.what() << std::endl;
+    }
+
+    // Dispositivo com falha: o trabalho dele volta para os demais
+    scheduler.retire(id);
+}
+
+// Busca nativa numa thread de CPU (sem dispositivo OpenCL); cada thread é
+// um "dispositivo" do escalonador
+void cpu_worker(size_t id, SimdIsa isa, WorkScheduler& scheduler,
+                CoverageMap& coverage, const SearchJob& job, HostTaskQueue& host_tasks,
+                Telemetry* telemetry) {
+    RankRange batch;
+    bool batch_pending = false;
+
+    try {
+        CpuSearchEngine engine(*job.space, job.spec.words, job.bip39_index, job.spec.paths,
+                               job.spec.targets, job.spec.gap, isa);
+        const uint64_t max_batch = 4096 * (job.spec.checksum ? 16 : 1);
+        std::vector<uint64_t> hits, samples;
+
+        while (!should_exit && scheduler.next_batch(id, max_batch, batch)) {
+            batch_pending = true;
+            auto batch_start = std::chrono::steady_clock::now();
+            StageCounters stages;
+            engine.search(batch, hits, samples, &stages);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - batch_start;
+
+            scheduler.report(id, batch.size(), elapsed.count());
+            coverage.add(batch);
+            batch_pending = false;
+            if (telemetry) {
+                telemetry->add(id, stages);
+            }
+
+            for (uint64_t rank : hits) {
+                host_tasks.post([&job, id, rank]() {
+                    if (confirm_hit(job, id, rank)) {
+                        found_address = true;
+                        should_exit = true;
+                    }
+                });
+            }
+            for (uint64_t rank : samples) {
+                std::vector<uint32_t> indices = job.space->unrank(rank);
+                std::array<uint32_t, 12> words;
+                std::copy(indices.begin(), indices.end(), words.begin());
+                host_tasks.post([&job, id, words]() { show_sample(job, id, words); });
+            }
+        }
+        return;
+
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        std::cerr << "Erro na thread de CPU " << id << ": " << e.what() << std::endl;
+    }
+
+    if (batch_pending) {
+        scheduler.release(batch);
+    }
+    scheduler.retire(id);
+}
+
+// Vazão por dispositivo e total; entradas seguidas com o mesmo nome (threads
+// do motor de CPU) são somadas numa linha
+void print_throughput(const WorkScheduler& scheduler, const std::vector<std::string>& names) {
+    uint64_t done = scheduler.completed();
+
+    std::lock_guard<std::mutex> lock(output_mutex);
+    std::cout << "\n----------------------------------------" << std::endl;
+    for (size_t i = 0; i < names.size();) {
+        size_t group_end = i;
+        double rate = 0.0;
+        uint64_t tested = 0, steals = 0;
+        while (group_end < names.size() && names[group_end] == names[i]) {
+            rate += scheduler.rate(group_end);
+            tested += scheduler.tested(group_end);
+            steals += scheduler.steals(group_end);
+            group_end++;
+        }
+
+        std::cout << "[" << i << "] " << names[i];
+        if (group_end - i > 1) {
+            std::cout << " x" << (group_end - i) << " threads";
+        }
+        std::cout << ": " << std::fixed << std::setprecision(0) << rate << " frases/s, "
+                  << tested << " testadas";
+        if (steals > 0) {
+            std::cout << ", " << steals << " blocos tomados";
+        }
+        std::cout << std::endl;
+        i = group_end;
+    }
+    std::cout << "Total: " << std::fixed << std::setprecision(0) << scheduler.total_rate()
+              << " frases/s" << std::endl;
+    std::cout << "Progresso: " << done << "/" << scheduler.total()
+              << " (" << std::fixed << std::setprecision(6)
+              << (done * 100.0 / scheduler.total()) << "%)" << std::endl;
+    std::cout << "----------------------------------------\n" << std::endl;
+}
+
+// Ctrl-C / SIGTERM: parar de lançar lotes, drenar os que estão em voo e
+// gravar o journal
+static_assert(std::atomic<bool>::is_always_lock_free,
+              "should_exit precisa ser lock-free para uso em signal handler");
+
+extern "C" void handle_stop_signal(int) {
+    should_exit = true;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Uso: " << program << " [--job <arquivo>] [--resume] [--journal <arquivo>] [--cpu]"
+              << " [--no-persistent] [--no-ec-table] [--stats-json <arquivo>]"
+              << " [--stats-prom <arquivo>] [--autotune] [--tuning <arquivo>]"
+              << " [--binary-cache <dir>] [--no-binary-cache] [--build-only] [--batch-ms <ms>]"
+              << std::endl;
+    std::cout << "  --job <arquivo>     palavras, posições conhecidas, alvo e caminho da busca" << std::endl;
+    std::cout << "                      (padrão: valores de globals.cpp)" << std::endl;
+    std::cout << "  --resume            retomar a partir do journal de progresso" << std::endl;
+    std::cout << "  --journal <arquivo> journal de progresso (padrão: progress.journal)" << std::endl;
+    std::cout << "  --cpu               usar o motor nativo de CPU mesmo com GPU disponível" << std::endl;
+    std::cout << "  --no-persistent     um work-item por rank (filter + verify) em vez do" << std::endl;
+    std::cout << "                      kernel persistente" << std::endl;
+    std::cout << "  --no-ec-table       k * G com wNAF em vez da tabela fixa de G ("
+              << EcTable::bytes() / 1024 << " KB por GPU)" << std::endl;
+    std::cout << "  --stats-json <arquivo> telemetria a cada 10 s em linhas JSON (acrescentadas)"
+              << std::endl;
+    std::cout << "  --stats-prom <arquivo> telemetria a cada 10 s num textfile do Prometheus"
+              << std::endl;
+    std::cout << "  --autotune          calibrar grupo, grade, lote e variante de cada GPU e gravar"
+              << std::endl;
+    std::cout << "                      no cache de ajuste" << std::endl;
+    std::cout << "  --tuning <arquivo>  cache de ajuste das GPUs (padrão: tuning.cache)"
+              << std::endl;
+    std::cout << "  --binary-cache <dir> binários compilados dos kernels (padrão: kernel_cache)"
+              << std::endl;
+    std::cout << "  --no-binary-cache   compilar os kernels sempre, sem ler nem gravar binários"
+              << std::endl;
+    std::cout << "  --build-only        compilar os kernels de todas as GPUs no cache e sair"
+              << std::endl;
+    std::cout << "  --batch-ms <ms>     duração alvo de cada lote nas GPUs (padrão: "
+              << BatchSizer::DEFAULT_TARGET_SECONDS * 1000 << "; 0 = lotes fixos)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
     // Configurar console para UTF-8
+#ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
+#endif
+    bool resume = false;
+    bool force_cpu = false;
+    bool persistent = true;
+    bool ec_table = true;
+    std::string journal_path = "progress.journal";
+    std::string job_path;
+    std::string stats_json, stats_prom;
+    std::string tuning_path = "tuning.cache";
+    bool autotune = false;
+    std::string binary_cache = "kernel_cache";
+    bool build_only = false;
+    double batch_ms = BatchSizer::DEFAULT_TARGET_SECONDS * 1000;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--resume") {
+            resume = true;
+        } else if (arg == "--cpu") {
+            force_cpu = true;
+        } else if (arg == "--no-persistent") {
+            persistent = false;
+        } else if (arg == "--no-ec-table") {
+            ec_table = false;
+        } else if (arg == "--journal" && i + 1 < argc) {
+            journal_path = argv[++i];
+        } else if (arg == "--job" && i + 1 < argc) {
+            job_path = argv[++i];
+        } else if (arg == "--autotune") {
+            autotune = true;
+        } else if (arg == "--tuning" && i + 1 < argc) {
+            tuning_path = argv[++i];
+        } else if (arg == "--binary-cache" && i + 1 < argc) {
+            binary_cache = argv[++i];
+        } else if (arg == "--no-binary-cache") {
+            binary_cache.clear();
+        } else if (arg == "--build-only") {
+            build_only = true;
+        } else if (arg == "--batch-ms" && i + 1 < argc) {
+            try {
+                batch_ms = std::stod(argv[++i]);
+            } catch (const std::exception&) {
+                batch_ms = -1.0;
+            }
+            if (batch_ms < 0.0) {
+                std::cerr << "--batch-ms inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--stats-json" && i + 1 < argc) {
+            stats_json = argv[++i];
+        } else if (arg == "--stats-prom" && i + 1 < argc) {
+            stats_prom = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (build_only && binary_cache.empty()) {
+        std::cerr << "--build-only precisa do cache de binários" << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, handle_stop_signal);
+    std::signal(SIGTERM, handle_stop_signal);
+
     std::cout << "Iniciando programa..." << std::endl;
 
     try {
+        // Job da busca: erros no arquivo aparecem antes de qualquer espera
+        SearchJob job;
+        job.spec = job_path.empty() ? JobSpec::defaults() : JobSpec::load(job_path);
+        SearchSpace space(job.spec.pool_size, job.spec.slots);
+        job.space = &space;
+        job.kernel_header = job.spec.kernel_header();
+        job.persistent = persistent;
+        job.ec_table = ec_table;
+        TuningCache tuning(tuning_path);
+        job.tuning = &tuning;
+        job.autotune = autotune;
+        job.batch_seconds = batch_ms / 1000.0;
+        std::unique_ptr<PassphraseSpace> passphrases;
+        if (job.spec.passphrase_mode()) {
+            // A frase é fixa: o checksum dela é conferido uma vez aqui
+            if (job.spec.checksum && !job.spec.known_checksum_ok()) {
+                throw std::runtime_error("A frase conhecida tem checksum BIP39 inválido "
+                                         "(use 'checksum off' para buscar mesmo assim)");
+            }
+            passphrases = std::make_unique<PassphraseSpace>(job.spec.passphrases, job.spec.mask);
+            job.passphrases = passphrases.get();
+            job.dictionary = passphrases->kernel_dictionary();
+        } else if (job.spec.checksum) {
+            job.bip39_index = job.spec.wordlist_indices();
+        }
+
+        // GPUs de todas as plataformas; sem GPU, motor nativo de CPU em todos
+        // os núcleos (mais rápido que o kernel OpenCL num dispositivo CPU)
+        std::vector<Device> devices;
+        if (!force_cpu) {
+            devices = OpenCLManager::discover_devices();
+        }
+        if (devices.empty() && job.passphrases) {
+            throw std::runtime_error("O modo passphrase precisa de uma GPU OpenCL");
+        }
+
+        // A compilação dos kernels (dezenas de segundos sem o cache de
+        // binários) corre junto com o teste e a espera do Enter
+        OpenCLManager::set_binary_cache(binary_cache);
+        PrebuildWait prebuild_wait{job.prebuilt};
+        for (const auto& device : devices) {
+            job.prebuilt.push_back(
+                std::async(std::launch::async, prebuild, std::cref(device), std::cref(job))
+                    .share());
+        }
+
+        // Só preparar o cache de binários (ex.: num nó antes dos workers)
+        if (build_only) {
+            if (devices.empty()) {
+                std::cout << "Nenhuma GPU para compilar" << std::endl;
+            }
+            int failed = 0;
+            for (size_t i = 0; i < devices.size(); i++) {
+                try {
+                    job.prebuilt[i].get();
+                    std::cout << "[" << i << "] " << OpenCLManager::describe(devices[i])
+                              << ": kernels em " << binary_cache << std::endl;
+                } catch (const std::exception& e) {
+                    std::cerr << "[" << i << "] " << OpenCLManager::describe(devices[i])
+                              << ": " << e.what() << std::endl;
+                    failed = 1;
+                }
+            }
+            return failed;
+        }
+
         // Primeiro executar o teste
         test_wallet();
         
-        std::cout << "\nPressione Enter para iniciar a busca...";
-        std::cin.get();
+        // Retomada pode rodar sem ninguém no console (ex.: após reinício)
+        if (!resume) {
+            std::cout << "\nPressione Enter para iniciar a busca...";
+            std::cin.get();
+        }
         
-        // Iniciar a busca com as 34 palavras
         std::cout << "\n=== Iniciando busca por carteira ===" << std::endl;
-        std::cout << "Usando " << FIXED_WORDS.size() << " palavras pré-configuradas." << std::endl;
-        
-        // Obter caminho do executável
-        std::string kernelPath = "kernel/";
-
-        // Usando o namespace cl para acessar as classes e funções do OpenCL
-        // Obter plataformas disponíveis
-        std::vector<Platform> platforms;
-        Platform::get(&platforms);
-        std::cout << "Plataformas OpenCL disponíveis: " << platforms.size() << std::endl;
-        
-        // Mostrar informações das plataformas
-        for(const auto& platform : platforms) {
-            std::cout << "Plataforma: " << platform.getInfo<CL_PLATFORM_NAME>() << std::endl;
-            std::cout << "Versão: " << platform.getInfo<CL_PLATFORM_VERSION>() << std::endl;
+        if (job_path.empty()) {
+            std::cout << "Usando " << job.spec.words.size() << " palavras pré-configuradas." << std::endl;
+        } else {
+            std::cout << "Job " << job_path << ": " << job.spec.words.size() << " palavras, "
+                      << space.free_slots().size() << " posições livres, "
+                      << job.spec.targets.size() << " alvo(s)" << std::endl;
         }
-
-        // Selecionar a primeira plataforma disponível
-        if(platforms.empty()) {
-            throw std::runtime_error("Nenhuma plataforma OpenCL encontrada");
+        size_t path_levels = 0;
+        for (const auto& path : job.spec.paths) {
+            for (const auto& leaf : job.spec.leaf_paths(path)) {
+                path_levels += leaf.size();
+            }
+        }
+        if (job.spec.gap > 0) {
+            std::cout << "Janela de " << job.spec.gap << " endereços (externos e troco) em "
+                      << job.spec.paths.size() << " conta(s)" << std::endl;
+        }
+        if (job.spec.paths.size() > 1 || job.spec.gap > 0) {
+            std::cout << job.spec.paths.size() << " caminhos: " << job.spec.derivation_steps()
+                      << " derivações por frase (" << path_levels << " sem prefixos comuns)"
+                      << std::endl;
         }
-        Platform platform = platforms[0];
 
-        // Obter dispositivos GPU
-        std::vector<Device> devices;
-        platform.getDevices(CL_DEVICE_TYPE_GPU, &devices);
-        
-        if(devices.empty()) {
-            std::cout << "Nenhum dispositivo GPU encontrado, tentando CPU..." << std::endl;
-            platform.getDevices(CL_DEVICE_TYPE_CPU, &devices);
-            if(devices.empty()) {
-                throw std::runtime_error("Nenhum dispositivo OpenCL encontrado");
+        std::vector<std::string> worker_names;
+        SimdIsa cpu_isa = Pbkdf2Lanes::detect();
+        if (!devices.empty()) {
+            std::cout << "Dispositivos OpenCL utilizáveis: " << devices.size() << std::endl;
+            for (size_t i = 0; i < devices.size(); i++) {
+                worker_names.push_back(OpenCLManager::describe(devices[i]));
+                std::cout << "[" << i << "] " << worker_names.back()
+                          << " - " << devices[i].getInfo<CL_DEVICE_VERSION>() << std::endl;
             }
+        } else {
+            size_t threads = std::max(1u, std::thread::hardware_concurrency());
+            std::string name = std::string("CPU nativa (") + Pbkdf2Lanes::name(cpu_isa) + ", " +
+                               std::to_string(Pbkdf2Lanes::lanes(cpu_isa)) + " lanes)";
+            worker_names.assign(threads, name);
+            std::cout << "Nenhuma GPU em uso; " << name << " em " << threads
+                      << " threads" << std::endl;
         }
 
-        // Mostrar informações dos dispositivos
-        for(const auto& device : devices) {
-            std::cout << "Dispositivo: " << device.getInfo<CL_DEVICE_NAME>() << std::endl;
-            std::cout << "Versão OpenCL: " << device.getInfo<CL_DEVICE_VERSION>() << std::endl;
+        // Espaço compartilhado com o kernel (permutation.cl + job_unrank gerado,
+        // ou o dicionário e job_mask no modo passphrase)
+        uint64_t total_combinations = job.total();
+        if (job.passphrases) {
+            std::cout << "Frase conhecida: " << job.spec.known_phrase() << std::endl;
+            std::cout << "Total de passphrases: " << total_combinations << " (dicionário "
+                      << std::max<size_t>(1, job.passphrases->dictionary().size())
+                      << " x máscara " << job.passphrases->mask_size() << ")" << std::endl;
+        } else {
+            std::cout << "Total de combinações possíveis: " << total_combinations
+                      << " (P(" << space.free_words().size() << ", "
+                      << space.free_slots().size() << ")";
+            for (uint32_t slot : space.subset_slots()) {
+                std::cout << " x " << space.slots()[slot].size();
+            }
+            std::cout << ")" << std::endl;
         }
-
-        // Criar contexto com o primeiro dispositivo
-        Context context({devices[0]});
-        CommandQueue queue(context);
-
-        std::vector<std::string> kernel_sources;
-        
-        // Carregar common.cl primeiro
-        std::ifstream ifs_common(kernelPath + "common.cl");
-        if (!ifs_common.is_open()) {
-            throw std::runtime_error("Não foi possível abrir common.cl");
-        }
-        std::string common_content((std::istreambuf_iterator<char>(ifs_common)), 
-                                 (std::istreambuf_iterator<char>()));
-        std::cout << "common.cl carregado com " << common_content.length() << " bytes" << std::endl;
-        
-        // Ler código fonte do kernel
-        std::string kernel_code = read_file("kernel/bip39.cl");
-        
-        // Criar fontes do programa
-        cl::Program::Sources sources;
-        sources.push_back({kernel_code.c_str(), kernel_code.length()});
-        
-        // Criar programa OpenCL
-        std::cout << "Criando programa OpenCL..." << std::endl;
-        cl::Program program(context, sources);
-        
-        // Salvar o código fonte para debug
-        std::ofstream debug_file("debug_kernel.cl");
-        debug_file << kernel_code;
-        debug_file.close();
-        
-        // Compilar programa
-        std::cout << "Compilando programa OpenCL..." << std::endl;
-        try {
-            program.build({devices[0]});
-        } catch (const cl::Error& e) {
-            std::cerr << "Log de erro de compilação para " << devices[0].getInfo<CL_DEVICE_NAME>() << ":" << std::endl
-                     << program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(devices[0]) << std::endl;
-            throw e;
+        if (space.needs_distinct_check() && !job.passphrases) {
+            std::cout << "Frases com palavra repetida são descartadas antes do PBKDF2" << std::endl;
         }
-        
-        std::cout << "Criando kernel..." << std::endl;
-        Kernel kernel(program, "verify");
-        std::cout << "Kernel criado com sucesso!" << std::endl;
-        
-        // Criar buffer para palavras fixas
-        std::vector<uint32_t> fixed_words_vec;
-        fixed_words_vec.reserve(FIXED_WORDS.size());
-        
-        // Converter strings para números
-        for (const auto& word : FIXED_WORDS) {
-            // Hash simples da palavra para uint32_t
-            uint32_t hash = 0;
-            for (char c : word) {
-                hash = hash * 31 + c;
-            }
-            fixed_words_vec.push_back(hash);
+        if (job.spec.checksum && !job.passphrases) {
+            std::cout << "Só frases com checksum BIP39 válido (1 em 16) passam pelo PBKDF2"
+                      << std::endl;
         }
-        
-        std::cout << "Criando buffer de palavras fixas..." << std::endl;
-        Buffer fixedWordsBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                             sizeof(uint32_t) * fixed_words_vec.size(),
-                             fixed_words_vec.data());
-        
-        std::cout << "Alocando buffer de resultado..." << std::endl;
-        Buffer resultBuffer(context, CL_MEM_WRITE_ONLY, sizeof(cl_ulong) * 2);
-        Buffer foundWordsBuffer(context, CL_MEM_WRITE_ONLY, sizeof(cl_uint) * 12);
-        std::cout << "Buffer alocado com sucesso!" << std::endl;
-        
-        // Calcular total de combinações
-        uint64_t total_combinations = 1;
-        for(uint64_t i = 34; i > 34-12; i--) {
-            total_combinations *= i;
+
+        // Journal de progresso: intervalos concluídos sobrevivem a quedas
+        ProgressJournal journal(journal_path, job.spec.describe(), total_combinations);
+        CoverageMap coverage;
+        if (resume) {
+            if (journal.exists()) {
+                journal.load(coverage);
+                std::cout << "Retomando de " << journal.path() << ": "
+                          << coverage.covered() << " combinações já testadas" << std::endl;
+            } else {
+                std::cout << "Journal " << journal.path()
+                          << " não encontrado, iniciando do zero" << std::endl;
+            }
+        } else if (journal.exists()) {
+            // Não sobrescrever progresso anterior sem querer (nem um backup
+            // de uma execução anterior sem --resume)
+            std::cout << "Journal anterior movido para " << journal.backup() << std::endl;
         }
-        
-        // Configurar tamanhos de trabalho
-        size_t local_size = 256;
-        
-        std::cout << "Total de combinações possíveis: " << total_combinations 
-                  << " (34C12 = 34!/(12! * 22!))" << std::endl;
         std::cout << "Iniciando busca..." << std::endl << std::endl;
-        
-        std::cout << "Configurando argumentos do kernel..." << std::endl;
-        kernel.setArg(0, fixedWordsBuffer);
-        kernel.setArg(1, resultBuffer);
-        kernel.setArg(2, foundWordsBuffer);
-        std::cout << "Argumentos configurados com sucesso!" << std::endl;
-        
-        // Variáveis para controle do progresso
-        size_t total_tested = 0;
-        const size_t progress_interval = 40500000; // Mostrar progresso a cada 40.5M tentativas
-        
-        // Função auxiliar para gerar frase de exemplo
-        auto generate_phrase = [](uint64_t index, const uint32_t* words, uint32_t* phrase) {
-            uint64_t remaining = index;
-            uint32_t used_words = 0;
-            
-            for(int i = 0; i < 12; i++) {
-                uint32_t word_idx = remaining % (34 - i);
-                remaining /= (34 - i);
-                
-                uint32_t count = 0;
-                for(uint32_t w = 0; w < 34; w++) {
-                    if(!(used_words & (1U << w))) {
-                        if(count == word_idx) {
-                            phrase[i] = w;
-                            used_words |= (1U << w);
-                            break;
-                        }
-                        count++;
-                    }
+
+        // Threads de CPU testam milhares de frases/s, não milhões: blocos menores
+        const uint64_t min_chunk = devices.empty() ? 4096 : (1ULL << 20);
+        WorkScheduler scheduler(0, total_combinations, coverage.gaps(0, total_combinations),
+                                worker_names.size(), 10.0, min_chunk);
+        // Confirmações e amostras num pool pequeno: as threads de busca
+        // (inclusive as de CPU) ficam com o resto dos núcleos
+        HostTaskQueue host_tasks(std::clamp(std::thread::hardware_concurrency() / 4, 1u, 4u));
+        // Contadores por estágio de cada dispositivo para o monitoramento
+        // externo, só se alguma saída foi pedida
+        std::unique_ptr<Telemetry> telemetry;
+        if (!stats_json.empty() || !stats_prom.empty()) {
+            telemetry = std::make_unique<Telemetry>(scheduler, worker_names, stats_json,
+                                                    stats_prom);
+            std::cout << "Telemetria a cada 10 s:"
+                      << (stats_json.empty() ? "" : " " + stats_json)
+                      << (stats_prom.empty() ? "" : " " + stats_prom) << std::endl;
+        }
+
+        std::atomic<size_t> active_workers{worker_names.size()};
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < worker_names.size(); i++) {
+            workers.emplace_back([&, i]() {
+                if (devices.empty()) {
+                    cpu_worker(i, cpu_isa, scheduler, coverage, job, host_tasks,
+                               telemetry.get());
+                } else {
+                    device_worker(i, devices[i], scheduler, coverage, job, host_tasks,
+                                  telemetry.get());
                 }
+                active_workers--;
+            });
+        }
+
+        // Relatório de vazão a cada 10 segundos e journal a cada 60 enquanto
+        // houver workers ativos
+        const auto report_interval = std::chrono::seconds(10);
+        const auto journal_interval = std::chrono::seconds(60);
+        auto last_report = std::chrono::steady_clock::now();
+        auto last_save = last_report;
+        bool stop_announced = false;
+        while (active_workers > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            auto now = std::chrono::steady_clock::now();
+            if (now - last_report >= report_interval) {
+                print_throughput(scheduler, worker_names);
+                last_report = now;
             }
-        };
-        
-        // Variáveis para cálculo de velocidade
-        auto start_time = std::chrono::high_resolution_clock::now();
-        uint64_t last_count = 0;
-        
-        // Loop principal
-        while (!should_exit && total_tested < total_combinations) {
-            size_t remaining = total_combinations - total_tested;
-            size_t batch_size = (remaining < (256ULL * 4096ULL)) ? remaining : (256ULL * 4096ULL);
-            batch_size = (batch_size / local_size) * local_size;
-            
-            if (batch_size == 0) break;  // Evitar erro quando batch_size < local_size
-            
-            cl::NDRange global(batch_size);
-            cl::NDRange local(local_size);
-            
-            if (total_tested % progress_interval == 0) {
-                std::cout << "\rProgresso: " << total_tested << "/" << total_combinations 
-                         << " (" << std::fixed << std::setprecision(2) 
-                         << (total_tested * 100.0 / total_combinations) << "%)";
-                
-                // Mostrar exemplo de frase sendo testada
-                std::vector<cl_uint> example_words(12);
-                generate_phrase(total_tested, fixed_words_vec.data(), example_words.data());
-                std::cout << "\nTestando frase: ";
-                for (int i = 0; i < 12; i++) {
-                    std::cout << FIXED_WORDS[example_words[i]] << " ";
+            if (now - last_save >= journal_interval) {
+                try {
+                    journal.save(coverage);
+                } catch (const std::exception& e) {
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cerr << "AVISO: " << e.what() << std::endl;
                 }
-                std::cout << "\nEndereço alvo: " << TARGET_ADDRESS << std::endl << std::endl;
-                std::cout.flush();
+                last_save = now;
             }
-            
-            try {
-                queue.enqueueNDRangeKernel(kernel, cl::NullRange, global, local);
-                queue.finish();
-                
-                // Ler resultados
-                std::vector<cl_ulong> result(2);
-                std::vector<cl_uint> found_words(12);
-                queue.enqueueReadBuffer(resultBuffer, CL_TRUE, 0, sizeof(cl_ulong) * 2, result.data());
-                queue.enqueueReadBuffer(foundWordsBuffer, CL_TRUE, 0, sizeof(cl_uint) * 12, found_words.data());
-                
-                // Verificar se encontrou
-                if (result[0] != 0) {
-                    // Construir frase encontrada
-                    std::string frase;
-                    for(int i = 0; i < 12; i++) {
-                        if(i > 0) frase += " ";
-                        frase += FIXED_WORDS[found_words[i]];
-                    }
-                    
-                    // Gerar seed e chaves
-                    auto seed = BIP39Utils::mnemonic_to_seed(frase);
-                    auto private_key = BitcoinUtils::derive_private_key(seed);
-                    std::string wif = BitcoinUtils::private_key_to_wif(private_key);
-                    std::string endereco = BitcoinUtils::derive_address(private_key);
-                    
-                    std::cout << "\n=== FRASE ENCONTRADA! ===" << std::endl;
-                    std::cout << "Frase: " << frase << std::endl;
-                    std::cout << "Endereço: " << endereco << std::endl;
-                    std::cout << "WIF: " << wif << std::endl;
-                    std::cout << "=======================" << std::endl;
-                    
-                    found_address = true;
-                    break;
-                }
-                
-                // Mostrar progresso a cada 100.000 tentativas
-                if (result[1] == 1) {
-                    // Construir frase atual
-                    std::string frase;
-                    std::set<std::string> palavras_usadas; // Para verificar repetições
-                    bool tem_repeticao = false;
-                    
-                    for(int i = 0; i < 12; i++) {
-                        if(i > 0) frase += " ";
-                        std::string palavra = FIXED_WORDS[found_words[i]];
-                        frase += palavra;
-                        
-                        // Verificar se a palavra já foi usada
-                        if(!palavras_usadas.insert(palavra).second) {
-                            tem_repeticao = true;
-                            std::cout << "\nAVISO: Palavra repetida: " << palavra << std::endl;
-                        }
-                    }
-                    
-                    if(tem_repeticao) {
-                        std::cout << "\nAVISO: Frase contém palavras repetidas!" << std::endl;
-                        std::cout << "ID: " << total_tested << std::endl;
-                        std::cout << "Frase: " << frase << std::endl;
-                        std::cout << "Índices: ";
-                        for(int i = 0; i < 12; i++) {
-                            std::cout << found_words[i] << " ";
-                        }
-                        std::cout << std::endl;
-                    }
-                    
-                    // Gerar seed e chaves
-                    auto seed = BIP39Utils::mnemonic_to_seed(frase);
-                    auto private_key = BitcoinUtils::derive_private_key(seed);
-                    std::string wif = BitcoinUtils::private_key_to_wif(private_key);
-                    std::string endereco = BitcoinUtils::derive_address(private_key);
-                    
-                    // Calcular velocidade
-                    auto current_time = std::chrono::high_resolution_clock::now();
-                    auto time_diff = std::chrono::duration_cast<std::chrono::seconds>(current_time - start_time).count();
-                    if (time_diff > 0) {
-                        uint64_t phrases_per_second = (total_tested - last_count) / time_diff;
-                        last_count = total_tested;
-                        start_time = current_time;
-                        
-                        std::cout << "\n----------------------------------------" << std::endl;
-                        std::cout << "Progresso: " << total_tested << "/" << total_combinations 
-                                  << " (" << std::fixed << std::setprecision(2) 
-                                  << (total_tested * 100.0 / total_combinations) << "%)" << std::endl;
-                        std::cout << "Velocidade: " << phrases_per_second << " frases/s" << std::endl;
-                        std::cout << "Frase atual: " << frase << std::endl;
-                        std::cout << "Endereço: " << endereco << std::endl;
-                        std::cout << "WIF: " << wif << std::endl;
-                        std::cout << "----------------------------------------\n" << std::endl;
-                    }
-                    result[1] = 0;  // Resetar flag
-                }
-                
-                total_tested += batch_size;
-                
-            } catch (const Error& e) {
-                std::cerr << "Erro OpenCL: " << e.what() << " (código: " << e.err() << ")" << std::endl;
-                std::cerr << "Detalhes adicionais:" << std::endl;
-                std::cerr << "- Tamanho do lote: " << batch_size << std::endl;
-                std::cerr << "- Tamanho do grupo local: " << local_size << std::endl;
-                std::cerr << "- Total testado: " << total_tested << std::endl;
-                if (e.err() == CL_INVALID_GLOBAL_OFFSET) {
-                    std::cerr << "Erro de offset global inválido - tentando continuar..." << std::endl;
-                    continue;
-                }
-                throw; // Re-lançar erro para debug
+            if (should_exit && !found_address && !stop_announced) {
+                std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << "\nInterrompendo: aguardando os lotes em voo..." << std::endl;
+                stop_announced = true;
             }
         }
-        
-        if (total_tested >= total_combinations) {
-            std::cout << "\nBusca concluída. Nenhuma correspondência encontrada." << std::endl;
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // Terminar as confirmações pendentes antes do resultado final
+        host_tasks.stop();
+        if (telemetry) {
+            telemetry->stop();
+        }
+
+        journal.save(coverage);
+        std::cout << "Progresso salvo em " << journal.path() << std::endl;
+
+        print_throughput(scheduler, worker_names);
+        if (!found_address) {
+            if (scheduler.completed() >= total_combinations) {
+                std::cout << "\nBusca concluída. Nenhuma correspondência encontrada." << std::endl;
+            } else {
+                std::cout << "\nBusca interrompida antes do fim do intervalo. "
+                          << "Use --resume para continuar." << std::endl;
+            }
         }
 
     } catch (const Error& e) {
@@ -445,8 +940,10 @@ int main() {
     }
 
     // Pausar antes de sair
+    if (!resume) {
         std::cout << "\nPressione Enter para sair...";
         std::cin.get();
+    }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,37 +1,104 @@
 #include "opencl_manager.hpp"
+#include "bitcoin_utils.hpp"
+#include <openssl/sha.h>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include <filesystem>
 
-void OpenCLManager::initialize() {
+namespace {
+
+std::string binary_cache_dir = "kernel_cache";
+
+bool is_usable(const cl::Device& device) {
+    return device.getInfo<CL_DEVICE_AVAILABLE>() &&
+           device.getInfo<CL_DEVICE_COMPILER_AVAILABLE>();
+}
+
+// getDevices lança exceção quando a plataforma não tem dispositivos do tipo
+void append_devices(const cl::Platform& platform, cl_device_type type,
+                    std::vector<cl::Device>& out) {
+    std::vector<cl::Device> devices;
     try {
-        // Obter plataformas disponíveis
-        std::vector<cl::Platform> platforms;
-        cl::Platform::get(&platforms);
-        if (platforms.empty()) {
-            throw std::runtime_error("Nenhuma plataforma OpenCL encontrada");
+        platform.getDevices(type, &devices);
+    } catch (const cl::Error&) {
+        return;
+    }
+    for (const auto& device : devices) {
+        if (is_usable(device)) {
+            out.push_back(device);
         }
+    }
+}
+
+} // namespace
+
+std::vector<cl::Device> OpenCLManager::discover_devices(cl_device_type type) {
+    std::vector<cl::Platform> platforms;
+    try {
+        cl::Platform::get(&platforms);
+    } catch (const cl::Error&) {
+        platforms.clear();
+    }
 
-        // Selecionar primeira plataforma
-        cl::Platform platform = platforms[0];
+    std::vector<cl::Device> devices;
+    for (const auto& platform : platforms) {
+        append_devices(platform, type, devices);
+    }
+    return devices;
+}
 
-        // Obter dispositivos disponíveis
-        std::vector<cl::Device> devices;
-        platform.getDevices(CL_DEVICE_TYPE_ALL, &devices);
-        if (devices.empty()) {
-            throw std::runtime_error("Nenhum dispositivo OpenCL encontrado");
+std::string OpenCLManager::describe(const cl::Device& device) {
+    cl::Platform platform(device.getInfo<CL_DEVICE_PLATFORM>());
+    return device.getInfo<CL_DEVICE_NAME>() + " (" +
+           platform.getInfo<CL_PLATFORM_NAME>() + ")";
+}
+
+std::string OpenCLManager::kernel_hash(const std::string& extra) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator("kernel")) {
+        if (entry.is_regular_file() && entry.path().extension() == ".cl") {
+            files.push_back(entry.path());
         }
+    }
+    std::sort(files.begin(), files.end());
 
-        // Selecionar primeiro dispositivo
-        cl::Device device = devices[0];
+    std::string data;
+    for (const auto& file : files) {
+        std::ifstream in(file, std::ios::binary);
+        data += file.filename().string() + '\n';
+        data.append(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    data += extra;
+
+    std::vector<uint8_t> digest(SHA256_DIGEST_LENGTH);
+    SHA256(reinterpret_cast<const uint8_t*>(data.data()), data.size(), digest.data());
+    return BitcoinUtils::bytes_to_hex(digest);
+}
+
+void OpenCLManager::initialize() {
+    std::vector<cl::Device> devices = discover_devices(CL_DEVICE_TYPE_ALL);
+    if (devices.empty()) {
+        throw std::runtime_error("Nenhum dispositivo OpenCL encontrado");
+    }
+    initialize(devices.front());
+}
+
+void OpenCLManager::initialize(const cl::Device& selected,
+                               cl_command_queue_properties properties) {
+    try {
+        device = selected;
 
         // Criar contexto
         context = cl::Context(device);
 
         // Criar fila de comandos
-        queue = cl::CommandQueue(context, device);
+        queue = cl::CommandQueue(context, device, properties);
 
     } catch (const cl::Error& e) {
         throw std::runtime_error("Erro OpenCL durante inicialização: " + 
@@ -40,43 +107,58 @@ void OpenCLManager::initialize() {
     }
 }
 
-void OpenCLManager::loadKernels() {
+void OpenCLManager::set_binary_cache(const std::string& dir) {
+    binary_cache_dir = dir;
+}
+
+void OpenCLManager::loadKernels(const std::string& file, const std::string& header,
+                                const std::string& options) {
     try {
+        // bip39.cl inclui os demais arquivos (main.cl, bip32.cl, ec.cl...)
         std::string kernel_path = "kernel";
-        std::vector<std::string> kernel_files = {
-            "main.cl",
-            "common.cl",
-            "sha256.cl",
-            "sha512_hmac.cl",
-            "ec.cl",
-            "bip39.cl"
-        };
-
-        std::string kernel_source;
-        for (const auto& file : kernel_files) {
-            std::ifstream kernel_file(kernel_path + "/" + file);
-            if (!kernel_file.is_open()) {
-                throw std::runtime_error("Não foi possível abrir o arquivo: " + file);
+        std::string build_options = "-I " + kernel_path + " " + options;
+
+        // Binário compilado antes para o mesmo fonte, opções, dispositivo e
+        // driver: sem passar pelo compilador
+        std::string binary_path;
+        binary_from_cache = false;
+        if (!binary_cache_dir.empty()) {
+            cl::Platform platform(device.getInfo<CL_DEVICE_PLATFORM>());
+            binary_path = binary_cache_dir + "/" +
+                kernel_hash(file + "\n" + header + "\n" + build_options + "\n" +
+                            describe(device) + "\n" + platform.getInfo<CL_PLATFORM_VERSION>() +
+                            "\n" + device.getInfo<CL_DRIVER_VERSION>()) + ".bin";
+            if (load_binary(binary_path, build_options)) {
+                binary_from_cache = true;
+                return;
             }
-            kernel_source += std::string(
-                std::istreambuf_iterator<char>(kernel_file),
-                std::istreambuf_iterator<char>()
-            );
-            kernel_file.close();
         }
 
+        std::ifstream kernel_file(kernel_path + "/" + file);
+        if (!kernel_file.is_open()) {
+            throw std::runtime_error("Não foi possível abrir o arquivo: " + file);
+        }
+        std::string kernel_source(
+            (std::istreambuf_iterator<char>(kernel_file)),
+            std::istreambuf_iterator<char>()
+        );
+
         // Criar programa a partir do código fonte
-        program = cl::Program(context, kernel_source);
+        // #line mantém os números de linha do log de compilação iguais aos do arquivo
+        program = cl::Program(context, header + "\n#line 1\n" + kernel_source);
 
         // Compilar programa
         try {
-            program.build();
+            program.build({device}, build_options.c_str());
         } catch (const cl::Error& e) {
             // Em caso de erro de compilação, mostrar log
-            std::string build_log = program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(
-                context.getInfo<CL_CONTEXT_DEVICES>()[0]
-            );
-            throw std::runtime_error("Erro ao compilar kernels:\n" + build_log);
+            std::string build_log = program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(device);
+            throw std::runtime_error("Erro ao compilar kernels para " + describe(device) +
+                                     ":\n" + build_log);
+        }
+
+        if (!binary_path.empty()) {
+            store_binary(binary_path);
         }
 
     } catch (const cl::Error& e) {
@@ -84,4 +166,54 @@ void OpenCLManager::loadKernels() {
                                std::string(e.what()) + " (" + 
                                std::to_string(e.err()) + ")");
     }
-} 
\ No newline at end of file
+}
+
+bool OpenCLManager::load_binary(const std::string& path, const std::string& options) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::vector<unsigned char> binary((std::istreambuf_iterator<char>(in)),
+                                      std::istreambuf_iterator<char>());
+    if (binary.empty()) {
+        return false;
+    }
+
+    // Binário truncado ou de outro driver: compilar do fonte e regravar
+    try {
+        program = cl::Program(context, {device}, cl::Program::Binaries{binary});
+        program.build({device}, options.c_str());
+        return true;
+    } catch (const cl::Error&) {
+        return false;
+    }
+}
+
+void OpenCLManager::store_binary(const std::string& path) {
+    // Falha ao gravar o cache só custa uma compilação na próxima vez
+    try {
+        auto binaries = program.getInfo<CL_PROGRAM_BINARIES>();
+        if (binaries.empty() || binaries.front().empty()) {
+            return;
+        }
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+
+        // Temporário por thread: dispositivos iguais podem gravar a mesma chave
+        std::ostringstream tmp_path;
+        tmp_path << path << "." << std::this_thread::get_id() << ".tmp";
+        {
+            std::ofstream out(tmp_path.str(), std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(binaries.front().data()),
+                      static_cast<std::streamsize>(binaries.front().size()));
+            out.close();
+            if (!out) {
+                std::filesystem::remove(tmp_path.str());
+                return;
+            }
+        }
+        std::filesystem::rename(tmp_path.str(), path);
+    } catch (const std::exception& e) {
+        std::cerr << "AVISO: binário do kernel não gravado em " << path << ": " << e.what()
+                  << std::endl;
+    }
+}
@@ -5,13 +5,49 @@
 #define CL_HPP_ENABLE_EXCEPTIONS
 
 #include <CL/opencl.hpp>
+#include <string>
+#include <vector>
 
+// Contexto, fila e programa de um único dispositivo. Cada dispositivo da
+// busca tem o seu próprio OpenCLManager.
 class OpenCLManager {
 public:
+    cl::Device device;
     cl::Context context;
     cl::Program program;
     cl::CommandQueue queue;
-    
+
+    // Todos os dispositivos utilizáveis do tipo pedido em todas as
+    // plataformas; lista vazia se não houver nenhum (ou nenhuma plataforma)
+    static std::vector<cl::Device> discover_devices(
+        cl_device_type type = CL_DEVICE_TYPE_GPU | CL_DEVICE_TYPE_ACCELERATOR);
+
+    // Nome do dispositivo com a plataforma, para logs
+    static std::string describe(const cl::Device& device);
+
+    // SHA-256 (hex) dos arquivos .cl de kernel/, em ordem de nome, seguidos
+    // de `extra`: muda com qualquer edição dos kernels, inclusive dos includes
+    static std::string kernel_hash(const std::string& extra = "");
+
+    // Diretório do cache de binários compilados (padrão kernel_cache; vazio
+    // desliga). Definido antes de criar as threads dos dispositivos.
+    static void set_binary_cache(const std::string& dir);
+
     void initialize();
-    void loadKernels();
-}; 
\ No newline at end of file
+    void initialize(const cl::Device& device, cl_command_queue_properties properties = 0);
+    // Compilar kernel/<file> (os includes são resolvidos com -I kernel).
+    // `header` é código gerado (JobSpec::kernel_header) compilado antes do arquivo.
+    // O binário (CL_PROGRAM_BINARIES) fica no cache de binários com o hash
+    // dos fontes, do cabeçalho, das opções, do dispositivo e do driver; um
+    // binário do cache dispensa a compilação. binary_from_cache diz se foi o caso.
+    void loadKernels(const std::string& file, const std::string& header,
+                     const std::string& options = "");
+
+    bool binary_from_cache = false;
+
+private:
+    // Programa do binário em cache para a chave; false se não houver ou se o
+    // driver o recusar
+    bool load_binary(const std::string& path, const std::string& options);
+    void store_binary(const std::string& path);
+};
@@ -0,0 +1,113 @@
+#include "passphrase_space.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char* const LOWER = "abcdefghijklmnopqrstuvwxyz";
+const char* const UPPER = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const char* const DIGITS = "0123456789";
+const char* const SYMBOLS = " !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+
+bool printable(const std::string& text) {
+    return std::all_of(text.begin(), text.end(), [](char c) { return c >= ' ' && c <= '~'; });
+}
+
+}  // namespace
+
+PassphraseSpace::PassphraseSpace(const std::vector<std::string>& dictionary,
+                                 const std::string& mask)
+    : dictionary_(dictionary), charsets_(parse_mask(mask)) {
+    if (dictionary_.empty() && charsets_.empty()) {
+        throw std::invalid_argument("Modo passphrase sem dicionário nem máscara");
+    }
+
+    size_t longest = 0;
+    for (const auto& word : dictionary_) {
+        if (!printable(word)) {
+            throw std::invalid_argument("Passphrase com caractere fora do ASCII imprimível "
+                                        "(sem normalização NFKD): " + word);
+        }
+        longest = std::max(longest, word.size());
+    }
+    if (longest + charsets_.size() > MAX_BYTES) {
+        throw std::invalid_argument("Passphrase pode passar de " + std::to_string(MAX_BYTES) +
+                                    " bytes, limite do kernel");
+    }
+
+    for (const auto& charset : charsets_) {
+        if (mask_size_ > UINT64_MAX / charset.size()) {
+            throw std::overflow_error("Espaço de passphrases não cabe em 64 bits");
+        }
+        mask_size_ *= charset.size();
+    }
+    const uint64_t words = std::max<size_t>(1, dictionary_.size());
+    if (mask_size_ > UINT64_MAX / words) {
+        throw std::overflow_error("Espaço de passphrases não cabe em 64 bits");
+    }
+    total_ = mask_size_ * words;
+}
+
+std::vector<std::string> PassphraseSpace::parse_mask(const std::string& mask) {
+    std::vector<std::string> charsets;
+    for (size_t i = 0; i < mask.size(); i++) {
+        if (mask[i] < ' ' || mask[i] > '~') {
+            throw std::invalid_argument("Caractere fora do ASCII imprimível na máscara: " + mask);
+        }
+        if (mask[i] != '?') {
+            charsets.push_back(std::string(1, mask[i]));
+            continue;
+        }
+        if (++i == mask.size()) {
+            throw std::invalid_argument("Máscara termina em '?': " + mask);
+        }
+        switch (mask[i]) {
+        case 'l': charsets.push_back(LOWER); break;
+        case 'u': charsets.push_back(UPPER); break;
+        case 'd': charsets.push_back(DIGITS); break;
+        case 'h': charsets.push_back(std::string(DIGITS) + "abcdef"); break;
+        case 'H': charsets.push_back(std::string(DIGITS) + "ABCDEF"); break;
+        case 's': charsets.push_back(SYMBOLS); break;
+        case 'a':
+            charsets.push_back(std::string(LOWER) + UPPER + DIGITS + SYMBOLS);
+            break;
+        case '?': charsets.push_back("?"); break;
+        default:
+            throw std::invalid_argument(std::string("Conjunto desconhecido na máscara: ?") +
+                                        mask[i]);
+        }
+    }
+    return charsets;
+}
+
+std::string PassphraseSpace::candidate(uint64_t rank) const {
+    if (rank >= total_) {
+        throw std::out_of_range("Rank fora do espaço de passphrases");
+    }
+    std::string out = dictionary_.empty() ? "" : dictionary_[rank / mask_size_];
+    rank %= mask_size_;
+    for (const auto& charset : charsets_) {
+        out += charset[rank % charset.size()];
+        rank /= charset.size();
+    }
+    return out;
+}
+
+std::vector<uint32_t> PassphraseSpace::kernel_dictionary() const {
+    std::vector<uint32_t> offsets;
+    std::string bytes;
+    for (const auto& word : dictionary_) {
+        offsets.push_back(static_cast<uint32_t>(bytes.size()));
+        bytes += word;
+        if (bytes.size() > UINT32_MAX) {
+            throw std::overflow_error("Dicionário de passphrases maior que 4 GB");
+        }
+    }
+    offsets.push_back(static_cast<uint32_t>(bytes.size()));
+
+    std::vector<uint32_t> out(offsets);
+    out.resize(offsets.size() + (bytes.size() + 3) / 4, 0);
+    std::memcpy(out.data() + offsets.size(), bytes.data(), bytes.size());
+    return out;
+}
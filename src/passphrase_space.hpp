@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Espaço de passphrases BIP39 (a "25ª palavra") do modo de recuperação da
+// passphrase: cada palavra de um dicionário seguida de cada combinação de
+// uma máscara no estilo do hashcat. Sem dicionário, só a máscara; sem
+// máscara, só as palavras. A máscara tem um conjunto por posição:
+//   ?l a-z   ?u A-Z   ?d 0-9   ?h 0-9a-f   ?H 0-9A-F
+//   ?s símbolos ASCII e espaço   ?a ?l?u?d?s   ?? '?'   outro caractere: literal
+// rank = palavra * mask_size() + dígitos da máscara, com a primeira posição
+// como dígito menos significativo. O kernel converte o rank da mesma forma
+// (job_mask, gerada por JobSpec::kernel_header).
+class PassphraseSpace {
+public:
+    // "mnemonic" + passphrase + INT(1), padding e comprimento num único
+    // bloco do SHA-512 (passphrase_salt em main.cl)
+    static const size_t MAX_BYTES = 99;
+
+    // Lança std::invalid_argument para máscara inválida, caractere fora do
+    // ASCII imprimível (sem normalização NFKD), passphrase longa demais ou
+    // espaço vazio; std::overflow_error se o espaço não cabe em 64 bits
+    PassphraseSpace(const std::vector<std::string>& dictionary, const std::string& mask);
+
+    // Conjunto de cada posição da máscara
+    static std::vector<std::string> parse_mask(const std::string& mask);
+
+    uint64_t total() const { return total_; }
+    uint64_t mask_size() const { return mask_size_; }
+    const std::vector<std::string>& dictionary() const { return dictionary_; }
+    const std::vector<std::string>& charsets() const { return charsets_; }
+
+    std::string candidate(uint64_t rank) const;
+
+    // Dicionário para o buffer do kernel: dictionary().size() + 1
+    // deslocamentos em bytes e depois as palavras concatenadas
+    std::vector<uint32_t> kernel_dictionary() const;
+
+private:
+    std::vector<std::string> dictionary_;
+    std::vector<std::string> charsets_;
+    uint64_t mask_size_ = 1;
+    uint64_t total_ = 0;
+};
@@ -0,0 +1,181 @@
+#include "progress_journal.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char* JOURNAL_HEADER = "# find_seed progress journal v1";
+
+} // namespace
+
+void CoverageMap::add(const RankRange& range) {
+    if (range.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint64_t begin = range.begin;
+    uint64_t end = range.end;
+
+    // Começar pelo intervalo anterior se ele encosta ou sobrepõe
+    auto it = intervals_.upper_bound(begin);
+    if (it != intervals_.begin()) {
+        auto prev = std::prev(it);
+        if (prev->second >= begin) {
+            it = prev;
+        }
+    }
+
+    while (it != intervals_.end() && it->first <= end) {
+        begin = std::min(begin, it->first);
+        end = std::max(end, it->second);
+        covered_ -= it->second - it->first;
+        it = intervals_.erase(it);
+    }
+
+    intervals_[begin] = end;
+    covered_ += end - begin;
+}
+
+uint64_t CoverageMap::covered() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return covered_;
+}
+
+std::vector<RankRange> CoverageMap::intervals() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<RankRange> out;
+    out.reserve(intervals_.size());
+    for (const auto& interval : intervals_) {
+        out.push_back({interval.first, interval.second});
+    }
+    return out;
+}
+
+std::vector<RankRange> CoverageMap::gaps(uint64_t begin, uint64_t end) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<RankRange> out;
+    uint64_t cursor = begin;
+    for (const auto& interval : intervals_) {
+        if (interval.second <= cursor) {
+            continue;
+        }
+        if (interval.first >= end) {
+            break;
+        }
+        if (interval.first > cursor) {
+            out.push_back({cursor, interval.first});
+        }
+        cursor = std::max(cursor, interval.second);
+    }
+    if (cursor < end) {
+        out.push_back({cursor, end});
+    }
+    return out;
+}
+
+ProgressJournal::ProgressJournal(std::string path, std::string job, uint64_t total)
+    : path_(std::move(path)), job_(std::move(job)), total_(total) {}
+
+bool ProgressJournal::exists() const {
+    return std::filesystem::exists(path_);
+}
+
+std::string ProgressJournal::backup() const {
+    std::string target = path_ + ".bak";
+    for (int n = 1; std::filesystem::exists(target); n++) {
+        target = path_ + ".bak." + std::to_string(n);
+    }
+    std::filesystem::rename(path_, target);
+    return target;
+}
+
+void ProgressJournal::load(CoverageMap& coverage) const {
+    std::ifstream file(path_);
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível abrir o journal: " + path_);
+    }
+
+    std::string line;
+    if (!std::getline(file, line) || line != JOURNAL_HEADER) {
+        throw std::runtime_error("Journal inválido: " + path_);
+    }
+    if (!std::getline(file, line) || line != "job " + job_) {
+        throw std::runtime_error("Journal pertence a outra busca (palavras, alvo ou caminho diferentes): " + path_);
+    }
+    if (!std::getline(file, line) || line != "total " + std::to_string(total_)) {
+        throw std::runtime_error("Journal com total de combinações diferente: " + path_);
+    }
+
+    std::vector<RankRange> ranges;
+    bool complete = false;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        if (line.rfind("end ", 0) == 0) {
+            std::string tag;
+            size_t count = 0;
+            fields >> tag >> count;
+            complete = (count == ranges.size());
+            break;
+        }
+
+        RankRange range;
+        if (!(fields >> range.begin >> range.end) || range.begin > range.end ||
+            range.end > total_) {
+            throw std::runtime_error("Journal corrompido na linha: " + line);
+        }
+        ranges.push_back(range);
+    }
+
+    if (!complete) {
+        throw std::runtime_error("Journal incompleto: " + path_);
+    }
+
+    for (const auto& range : ranges) {
+        coverage.add(range);
+    }
+}
+
+void ProgressJournal::save(const CoverageMap& coverage) const {
+    std::vector<RankRange> ranges = coverage.intervals();
+
+    std::ostringstream out;
+    out << JOURNAL_HEADER << "\n";
+    out << "job " << job_ << "\n";
+    out << "total " << total_ << "\n";
+    for (const auto& range : ranges) {
+        out << range.begin << " " << range.end << "\n";
+    }
+    out << "end " << ranges.size() << "\n";
+    std::string data = out.str();
+
+    // Gravar e sincronizar o temporário antes de renomear
+    std::string tmp_path = path_ + ".tmp";
+    FILE* file = std::fopen(tmp_path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Não foi possível criar " + tmp_path);
+    }
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+              std::fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        throw std::runtime_error("Erro ao gravar " + tmp_path);
+    }
+
+    std::filesystem::rename(tmp_path, path_);
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "work_scheduler.hpp"
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Conjunto de intervalos de ranks concluídos. Intervalos sobrepostos ou
+// adjacentes são unidos, então lotes concluídos fora de ordem ou por vários
+// dispositivos não deixam buracos.
+class CoverageMap {
+public:
+    void add(const RankRange& range);
+
+    uint64_t covered() const;
+    std::vector<RankRange> intervals() const;
+
+    // Partes de [begin, end) ainda não cobertas
+    std::vector<RankRange> gaps(uint64_t begin, uint64_t end) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::map<uint64_t, uint64_t> intervals_;  // begin -> end, disjuntos
+    uint64_t covered_ = 0;
+};
+
+// Arquivo de progresso da busca. Guarda a descrição do job (palavras, alvo,
+// caminho) para não retomar uma busca diferente, e os intervalos concluídos.
+// Cada gravação vai para <path>.tmp e é renomeada por cima do arquivo, então
+// uma queda no meio da escrita preserva o journal anterior.
+class ProgressJournal {
+public:
+    ProgressJournal(std::string path, std::string job, uint64_t total);
+
+    bool exists() const;
+    const std::string& path() const { return path_; }
+    // Move o arquivo para o primeiro nome livre entre <path>.bak,
+    // <path>.bak.1, <path>.bak.2... e retorna esse nome. Nunca substitui um
+    // backup anterior.
+    std::string backup() const;
+
+    // Lança std::runtime_error se o arquivo for de outro job ou estiver corrompido
+    void load(CoverageMap& coverage) const;
+    void save(const CoverageMap& coverage) const;
+
+private:
+    std::string path_;
+    std::string job_;
+    uint64_t total_;
+};
@@ -0,0 +1,111 @@
+#include "search_program.hpp"
+#include "ec_table.hpp"
+#include <algorithm>
+
+namespace {
+
+// Maior grupo local dos kernels filter + verify (EC_GROUP_MAX_LOCAL em ec.cl)
+const size_t COMPACT_MAX_LOCAL = 256;
+
+} // namespace
+
+std::string LaunchConfig::describe() const {
+    std::string out = persistent
+        ? "persistente, " + std::to_string(groups_per_cu) + " grupos/CU x " +
+              std::to_string(local_size)
+        : "filter + verify, lotes de " + std::to_string(batch) + " x " +
+              std::to_string(local_size);
+    return out + (ec_table ? ", tabela de G" : ", wNAF");
+}
+
+SearchProgram::SearchProgram(const cl::Device& device, const std::string& header,
+                             bool ec_table, const std::vector<uint32_t>& dictionary)
+    : ec_table_(ec_table &&
+                device.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>() >= EcTable::bytes()) {
+    manager_.initialize(device, CL_QUEUE_PROFILING_ENABLE);
+    manager_.loadKernels("bip39.cl", header, ec_table_ ? "-D EC_FIXED_BASE=1" : "");
+    table_ = ec_table_
+        ? cl::Buffer(manager_.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, EcTable::bytes(),
+                     const_cast<uint32_t*>(EcTable::generator().data()))
+        : cl::Buffer(manager_.context, CL_MEM_READ_ONLY, sizeof(cl_uint));
+    dictionary_ = dictionary.empty()
+        ? cl::Buffer(manager_.context, CL_MEM_READ_ONLY, sizeof(cl_uint))
+        : cl::Buffer(manager_.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                     sizeof(uint32_t) * dictionary.size(),
+                     const_cast<uint32_t*>(dictionary.data()));
+
+    filter_ = cl::Kernel(manager_.program, "filter");
+    verify_ = cl::Kernel(manager_.program, "verify");
+    persistent_ = cl::Kernel(manager_.program, "search_persistent");
+    verify_.setArg(4, table_);
+    verify_.setArg(5, dictionary_);
+    persistent_.setArg(5, table_);
+    persistent_.setArg(6, dictionary_);
+}
+
+LaunchConfig SearchProgram::resolve(LaunchConfig config, bool checksum) {
+    config.ec_table = ec_table_;
+    const size_t limit = max_local(config.persistent);
+    config.local_size = config.local_size == 0 ? limit : std::min(config.local_size, limit);
+    config.groups_per_cu = std::max<size_t>(1, config.groups_per_cu);
+    if (config.batch == 0) {
+        // Com o checksum só 1 em 16 ranks chega ao PBKDF2: lotes 16x maiores
+        // mantêm o mesmo número de frases por lançamento
+        config.batch = 256ULL * 4096ULL * (checksum ? 16 : 1);
+    }
+    return config;
+}
+
+std::unique_ptr<DispatchEngine> SearchProgram::engine(const LaunchConfig& config,
+                                                      uint64_t& max_batch) {
+    if (config.persistent) {
+        // Grade do tamanho da ocupação: alguns grupos por unidade de
+        // computação, cada um pegando blocos de ranks até o fim do lote. O
+        // lote é o bloco inteiro que o escalonador atribuir.
+        max_batch = UINT64_MAX;
+        return std::make_unique<DispatchEngine>(manager_, persistent_, config.local_size,
+                                                compute_units() * config.groups_per_cu);
+    }
+    max_batch = config.batch;
+    return std::make_unique<DispatchEngine>(manager_, filter_, verify_, config.local_size,
+                                            config.batch);
+}
+
+size_t SearchProgram::max_local(bool persistent) {
+    const cl::Device& device = manager_.device;
+    if (persistent) {
+        return std::min(static_cast<size_t>(DispatchEngine::PERSISTENT_MAX_LOCAL),
+                        persistent_.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(device));
+    }
+    return std::min<size_t>({COMPACT_MAX_LOCAL,
+                             filter_.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(device),
+                             verify_.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(device)});
+}
+
+size_t SearchProgram::preferred_multiple(bool persistent) {
+    const cl::Kernel& kernel = persistent ? persistent_ : verify_;
+    size_t multiple =
+        kernel.getWorkGroupInfo<CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE>(manager_.device);
+    return std::max<size_t>(1, multiple);
+}
+
+size_t SearchProgram::resident_groups(bool persistent) {
+    const cl::Kernel& kernel = persistent ? persistent_ : verify_;
+    cl_ulong used = kernel.getWorkGroupInfo<CL_KERNEL_LOCAL_MEM_SIZE>(manager_.device);
+    cl_ulong available = manager_.device.getInfo<CL_DEVICE_LOCAL_MEM_SIZE>();
+    return std::max<size_t>(1, used > 0 ? static_cast<size_t>(available / used) : 1);
+}
+
+size_t SearchProgram::compute_units() const {
+    return std::max<size_t>(1, manager_.device.getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>());
+}
+
+uint64_t SearchProgram::min_batch(const LaunchConfig& config) const {
+    return static_cast<uint64_t>(compute_units()) * config.local_size *
+           (config.persistent ? config.groups_per_cu : 1);
+}
+
+cl_ulong SearchProgram::private_bytes(bool persistent) {
+    const cl::Kernel& kernel = persistent ? persistent_ : verify_;
+    return kernel.getWorkGroupInfo<CL_KERNEL_PRIVATE_MEM_SIZE>(manager_.device);
+}
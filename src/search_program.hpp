@@ -0,0 +1,73 @@
+#pragma once
+#include "dispatch_engine.hpp"
+#include "opencl_manager.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Configuração de lançamento da busca num dispositivo: a padrão ou a
+// escolhida pelo Autotuner. Zeros são resolvidos por SearchProgram::resolve.
+struct LaunchConfig {
+    bool persistent = true;      // search_persistent; false = filter + verify
+    bool ec_table = true;        // tabela fixa de G (EC_FIXED_BASE)
+    size_t local_size = 0;       // work-items por grupo (0 = maior aceito, até 256)
+    size_t groups_per_cu = 4;    // modo persistente: grupos por unidade de computação
+                                 // (o bastante para esconder a latência de memória)
+    uint64_t batch = 0;          // modo compactado: ranks por lote (0 = padrão)
+
+    // "persistente, 4 grupos/CU x 256, tabela de G"
+    std::string describe() const;
+};
+
+// Programa de busca de um job compilado para um dispositivo, a tabela de G e
+// os kernels. O programa só depende de ec_table: configurações que mudam o
+// grupo, a grade ou o lote criam outro DispatchEngine sem recompilar.
+class SearchProgram {
+public:
+    // Compila kernel/bip39.cl com o cabeçalho do job, numa fila com
+    // profiling (BatchResult::kernel_seconds). A tabela fixa de G só
+    // é usada se o dispositivo comporta o buffer; senão o kernel sai com o
+    // wNAF e a tabela pequena em __constant (ec_table() diz qual).
+    // dictionary é o dicionário do modo passphrase
+    // (PassphraseSpace::kernel_dictionary; vazio fora dele).
+    SearchProgram(const cl::Device& device, const std::string& header, bool ec_table,
+                  const std::vector<uint32_t>& dictionary = {});
+
+    SearchProgram(const SearchProgram&) = delete;
+    SearchProgram& operator=(const SearchProgram&) = delete;
+
+    bool ec_table() const { return ec_table_; }
+    OpenCLManager& manager() { return manager_; }
+
+    // Preenche os zeros de `config` com os padrões deste dispositivo e
+    // limita o grupo local ao que os kernels aceitam
+    LaunchConfig resolve(LaunchConfig config, bool checksum);
+
+    // DispatchEngine para `config` (resolvida); max_batch é o maior lote a
+    // pedir ao escalonador. Só um engine por vez: o anterior deve ter sido
+    // destruído, pois os kernels são compartilhados.
+    std::unique_ptr<DispatchEngine> engine(const LaunchConfig& config, uint64_t& max_batch);
+
+    // Limites do dispositivo para o modo: maior grupo local aceito (até
+    // 256), múltiplo preferido do grupo e grupos que cabem na memória local
+    // de uma unidade de computação
+    size_t max_local(bool persistent);
+    size_t preferred_multiple(bool persistent);
+    size_t resident_groups(bool persistent);
+    size_t compute_units() const;
+    // Menor lote que ocupa o dispositivo (um bloco por grupo da grade
+    // persistente, ou um grupo por unidade de computação): a granularidade
+    // do BatchSizer
+    uint64_t min_batch(const LaunchConfig& config) const;
+    // Memória privada por work-item do kernel do PBKDF2: o que passa dos
+    // registradores vira spill em memória global
+    cl_ulong private_bytes(bool persistent);
+
+private:
+    OpenCLManager manager_;
+    bool ec_table_;
+    cl::Buffer table_;
+    cl::Buffer dictionary_;
+    cl::Kernel filter_, verify_, persistent_;
+};
@@ -0,0 +1,172 @@
+#include "search_space.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Posições livres e pool livre antes de construir o PermutationRank
+std::vector<uint32_t> collect_free(uint32_t pool_size,
+                                   const std::vector<std::vector<uint32_t>>& slots,
+                                   std::vector<uint32_t>& free_slots) {
+    std::vector<bool> fixed(PermutationRank::MAX_POOL_SIZE, false);
+    for (size_t i = 0; i < slots.size(); i++) {
+        for (uint32_t word : slots[i]) {
+            if (word >= PermutationRank::MAX_POOL_SIZE) {
+                throw std::invalid_argument("Palavra fora da tabela na posição " +
+                                            std::to_string(i + 1));
+            }
+        }
+        if (slots[i].empty()) {
+            free_slots.push_back(static_cast<uint32_t>(i));
+        } else if (slots[i].size() == 1) {
+            if (fixed[slots[i][0]]) {
+                throw std::invalid_argument("Palavra fixa repetida na posição " +
+                                            std::to_string(i + 1));
+            }
+            fixed[slots[i][0]] = true;
+        }
+    }
+
+    std::vector<uint32_t> free_words;
+    for (uint32_t w = 0; w < pool_size; w++) {
+        if (!fixed[w]) {
+            free_words.push_back(w);
+        }
+    }
+    return free_words;
+}
+
+}  // namespace
+
+SearchSpace::SearchSpace(uint32_t pool_size, const std::vector<std::vector<uint32_t>>& slots)
+    : pool_size_(pool_size), slots_(slots),
+      free_words_(collect_free(pool_size, slots, free_slots_)),
+      free_index_(PermutationRank::MAX_POOL_SIZE, 0),
+      // Sem posições livres a permutação é P(1, 1), uma única frase
+      perm_(free_slots_.empty() ? 1 : static_cast<uint32_t>(free_words_.size()),
+            free_slots_.empty() ? 1 : static_cast<uint32_t>(free_slots_.size())) {
+    for (uint32_t i = 0; i < free_words_.size(); i++) {
+        free_index_[free_words_[i]] = i;
+    }
+
+    // Dígitos dos subconjuntos: última posição da frase varia mais rápido.
+    // Uma candidata que também pode sair de outra posição (pool livre, palavra
+    // fixa ou outro subconjunto) exige a verificação de repetidas.
+    uint64_t seen = 0;
+    for (const auto& candidates : slots_) {
+        if (candidates.size() == 1) {
+            seen |= 1ULL << candidates[0];
+        }
+    }
+    if (!free_slots_.empty()) {
+        for (uint32_t w : free_words_) {
+            seen |= 1ULL << w;
+        }
+    }
+    for (int i = static_cast<int>(slots_.size()) - 1; i >= 0; i--) {
+        const auto& candidates = slots_[i];
+        if (candidates.size() < 2) {
+            continue;
+        }
+        subset_slots_.push_back(static_cast<uint32_t>(i));
+        if (subset_total_ > UINT64_MAX / candidates.size()) {
+            throw std::overflow_error("Espaço de busca não cabe em 64 bits");
+        }
+        subset_total_ *= candidates.size();
+
+        for (uint32_t word : candidates) {
+            if (seen & (1ULL << word)) {
+                needs_distinct_check_ = true;
+            }
+        }
+        for (uint32_t word : candidates) {
+            seen |= 1ULL << word;
+        }
+    }
+
+    if (free_slots_.empty()) {
+        total_ = subset_total_;
+    } else {
+        if (perm_.total() > UINT64_MAX / subset_total_) {
+            throw std::overflow_error("Espaço de busca não cabe em 64 bits");
+        }
+        total_ = perm_.total() * subset_total_;
+    }
+}
+
+bool SearchSpace::distinct(const uint32_t* phrase) const {
+    if (!needs_distinct_check_) {
+        return true;
+    }
+    uint64_t used = 0;
+    for (size_t i = 0; i < slots_.size(); i++) {
+        uint64_t bit = 1ULL << phrase[i];
+        if (used & bit) {
+            return false;
+        }
+        used |= bit;
+    }
+    return true;
+}
+
+void SearchSpace::unrank(uint64_t rank, uint32_t* phrase) const {
+    if (rank >= total_) {
+        throw std::out_of_range("Rank fora do espaço de busca");
+    }
+
+    for (uint32_t slot : subset_slots_) {
+        const auto& candidates = slots_[slot];
+        phrase[slot] = candidates[rank % candidates.size()];
+        rank /= candidates.size();
+    }
+    for (size_t i = 0; i < slots_.size(); i++) {
+        if (slots_[i].size() == 1) {
+            phrase[i] = slots_[i][0];
+        }
+    }
+    if (free_slots_.empty()) {
+        return;
+    }
+
+    uint32_t perm[PermutationRank::MAX_POOL_SIZE];
+    perm_.unrank(rank, perm);
+    for (size_t k = 0; k < free_slots_.size(); k++) {
+        phrase[free_slots_[k]] = free_words_[perm[k]];
+    }
+}
+
+std::vector<uint32_t> SearchSpace::unrank(uint64_t rank) const {
+    std::vector<uint32_t> phrase(slots_.size());
+    unrank(rank, phrase.data());
+    return phrase;
+}
+
+bool SearchSpace::next(uint32_t* phrase) const {
+    // Incrementar os dígitos dos subconjuntos; o vai-um final avança a permutação
+    for (uint32_t slot : subset_slots_) {
+        const auto& candidates = slots_[slot];
+        size_t digit = std::find(candidates.begin(), candidates.end(), phrase[slot]) -
+                       candidates.begin();
+        if (digit + 1 < candidates.size()) {
+            phrase[slot] = candidates[digit + 1];
+            return true;
+        }
+        phrase[slot] = candidates[0];
+    }
+    if (free_slots_.empty()) {
+        return false;
+    }
+
+    uint32_t perm[PermutationRank::MAX_POOL_SIZE];
+    for (size_t k = 0; k < free_slots_.size(); k++) {
+        perm[k] = free_index_[phrase[free_slots_[k]]];
+    }
+    if (!perm_.next(perm)) {
+        return false;
+    }
+    for (size_t k = 0; k < free_slots_.size(); k++) {
+        phrase[free_slots_[k]] = free_words_[perm[k]];
+    }
+    return true;
+}
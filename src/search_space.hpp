@@ -0,0 +1,55 @@
+#pragma once
+#include "kernel/permutation.hpp"
+#include <cstdint>
+#include <vector>
+
+// Espaço de frases de uma busca. Cada posição tem seu conjunto de candidatas:
+//   - uma palavra: posição conhecida, fica fixa;
+//   - várias: subconjunto, vira um dígito de base |candidatas|;
+//   - nenhuma: qualquer palavra do pool que não esteja fixa.
+// As posições livres são uma permutação do pool livre (PermutationRank) e os
+// subconjuntos são dígitos mistos abaixo dela:
+//   rank = perm_rank * prod(|C_s|) + dígitos dos subconjuntos
+// com o último subconjunto da frase como dígito menos significativo. O kernel
+// converte o rank da mesma forma (job_unrank, gerado por JobSpec::kernel_header).
+class SearchSpace {
+public:
+    // As palavras [0, pool_size) formam o pool das posições livres; índices
+    // maiores só aparecem em posições conhecidas ou subconjuntos
+    SearchSpace(uint32_t pool_size, const std::vector<std::vector<uint32_t>>& slots);
+
+    uint64_t total() const { return total_; }
+    uint32_t length() const { return static_cast<uint32_t>(slots_.size()); }
+    uint32_t pool_size() const { return pool_size_; }
+
+    const std::vector<std::vector<uint32_t>>& slots() const { return slots_; }
+    // Palavras do pool disponíveis para as posições livres, em ordem
+    const std::vector<uint32_t>& free_words() const { return free_words_; }
+    const std::vector<uint32_t>& free_slots() const { return free_slots_; }
+    // Posições com subconjunto, do dígito menos significativo para o mais
+    const std::vector<uint32_t>& subset_slots() const { return subset_slots_; }
+
+    // Um subconjunto pode repetir uma palavra de outra posição; essas frases
+    // contam no rank mas são descartadas antes do PBKDF2
+    bool needs_distinct_check() const { return needs_distinct_check_; }
+    bool distinct(const uint32_t* phrase) const;
+
+    // Índices das length() palavras da frase
+    void unrank(uint64_t rank, uint32_t* phrase) const;
+    std::vector<uint32_t> unrank(uint64_t rank) const;
+
+    // Frase do rank seguinte; false quando já era a última
+    bool next(uint32_t* phrase) const;
+
+private:
+    uint32_t pool_size_;
+    std::vector<std::vector<uint32_t>> slots_;
+    std::vector<uint32_t> free_slots_;
+    std::vector<uint32_t> subset_slots_;
+    std::vector<uint32_t> free_words_;
+    std::vector<uint32_t> free_index_;   // palavra do pool -> índice em free_words_
+    uint64_t subset_total_ = 1;          // prod(|C_s|)
+    uint64_t total_ = 0;
+    bool needs_distinct_check_ = false;
+    PermutationRank perm_;
+};
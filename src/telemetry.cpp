@@ -0,0 +1,285 @@
+#include "telemetry.hpp"
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+std::string json_string(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        if (static_cast<unsigned char>(c) >= 0x20) {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+// Valor de label do Prometheus: aspas, barra invertida e quebra de linha escapadas
+std::string label_value(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+double per_second(uint64_t now, uint64_t before, double seconds) {
+    return seconds > 0.0 ? static_cast<double>(now - before) / seconds : 0.0;
+}
+
+// Ranks por segundo de todos os dispositivos na janela
+double enumerated_rate(const std::vector<StageCounters>& now,
+                       const std::vector<StageCounters>& before, double seconds) {
+    double rate = 0.0;
+    for (size_t i = 0; i < now.size(); i++) {
+        rate += per_second(now[i].enumerated, before[i].enumerated, seconds);
+    }
+    return rate;
+}
+
+} // namespace
+
+StageCounters& StageCounters::operator+=(const StageCounters& other) {
+    enumerated += other.enumerated;
+    distinct += other.distinct;
+    accepted += other.accepted;
+    seeds += other.seeds;
+    keys += other.keys;
+    hits += other.hits;
+    return *this;
+}
+
+Telemetry::Telemetry(const WorkScheduler& scheduler, const std::vector<std::string>& workers,
+                     const std::string& json_path, const std::string& prom_path,
+                     double interval, double window)
+    : scheduler_(scheduler), prom_path_(prom_path), interval_(interval), window_(window),
+      start_(std::chrono::steady_clock::now()) {
+    if (interval <= 0.0 || window < interval) {
+        throw std::invalid_argument("Intervalo ou janela de telemetria inválidos");
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+        if (i == 0 || workers[i] != workers[i - 1]) {
+            names_.push_back(workers[i]);
+            threads_of_.push_back(0);
+        }
+        device_of_.push_back(names_.size() - 1);
+        threads_of_.back()++;
+    }
+    if (!json_path.empty()) {
+        json_.open(json_path, std::ios::app);
+        if (!json_) {
+            throw std::runtime_error("Não foi possível abrir " + json_path);
+        }
+    }
+    totals_.resize(names_.size());
+    history_.push_back(Sample{0.0, totals_});
+    thread_ = std::thread(&Telemetry::loop, this);
+}
+
+Telemetry::~Telemetry() {
+    stop();
+}
+
+void Telemetry::add(size_t worker, const StageCounters& counters) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    totals_.at(device_of_.at(worker)) += counters;
+}
+
+void Telemetry::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void Telemetry::loop() {
+    const auto period = std::chrono::duration<double>(interval_);
+    auto next = start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+    bool last = false;
+    while (!last) {
+        Sample sample;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_until(lock, next, [this] { return stopping_; });
+            last = stopping_;
+            sample.devices = totals_;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+        sample.seconds = elapsed.count();
+        next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+
+        // Falha de escrita (disco cheio, diretório removido) não para a busca
+        try {
+            write(sample);
+        } catch (const std::exception& e) {
+            if (!warned_) {
+                std::cerr << "\nAVISO: telemetria: " << e.what() << std::endl;
+                warned_ = true;
+            }
+        }
+    }
+}
+
+void Telemetry::write(const Sample& sample) {
+    // Manter a amostra mais nova com pelo menos `window` segundos de idade:
+    // as taxas são a média de uma janela completa (ou desde o início)
+    history_.push_back(sample);
+    while (history_.size() > 1 && sample.seconds - history_[1].seconds >= window_) {
+        history_.pop_front();
+    }
+
+    const uint64_t completed = scheduler_.completed();
+    if (json_.is_open()) {
+        write_json(sample, history_.front(), completed);
+    }
+    if (!prom_path_.empty()) {
+        write_prometheus(sample, history_.front(), completed);
+    }
+}
+
+void Telemetry::write_json(const Sample& sample, const Sample& oldest, uint64_t completed) {
+    const double span = sample.seconds - oldest.seconds;
+    const double rate = enumerated_rate(sample.devices, oldest.devices, span);
+    const uint64_t total = scheduler_.total();
+    const double unix_time = std::chrono::duration<double>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1)
+        << "{\"time\": " << unix_time
+        << ", \"elapsed\": " << sample.seconds
+        << ", \"window\": " << span
+        << ", \"completed\": " << completed
+        << ", \"total\": " << total
+        << ", \"rate\": " << rate
+        << ", \"eta_seconds\": ";
+    if (rate > 0.0) {
+        out << static_cast<double>(total - completed) / rate;
+    } else {
+        out << "null";
+    }
+    out << ", \"devices\": [";
+    for (size_t i = 0; i < names_.size(); i++) {
+        const StageCounters& now = sample.devices[i];
+        const StageCounters& before = oldest.devices[i];
+        out << (i ? ", " : "")
+            << "{\"device\": " << i
+            << ", \"name\": " << json_string(names_[i])
+            << ", \"threads\": " << threads_of_[i]
+            << ", \"enumerated\": " << now.enumerated
+            << ", \"repeated\": " << now.enumerated - now.distinct
+            << ", \"checksum_rejected\": " << now.distinct - now.accepted
+            << ", \"pbkdf2\": " << now.seeds
+            << ", \"keys\": " << now.keys
+            << ", \"hits\": " << now.hits
+            << ", \"rates\": {\"enumerated\": "
+            << per_second(now.enumerated, before.enumerated, span)
+            << ", \"pbkdf2\": " << per_second(now.seeds, before.seeds, span)
+            << ", \"keys\": " << per_second(now.keys, before.keys, span) << "}}";
+    }
+    out << "]}\n";
+
+    json_ << out.str();
+    json_.flush();
+    if (!json_) {
+        throw std::runtime_error("Erro ao gravar a linha JSON");
+    }
+}
+
+void Telemetry::write_prometheus(const Sample& sample, const Sample& oldest,
+                                 uint64_t completed) {
+    const double span = sample.seconds - oldest.seconds;
+    const double rate = enumerated_rate(sample.devices, oldest.devices, span);
+    const uint64_t total = scheduler_.total();
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    auto labels = [&](size_t device) {
+        return "device=\"" + std::to_string(device) + "\",name=" + label_value(names_[device]);
+    };
+
+    out << "# HELP find_seed_phrases_total Frases por estágio do pipeline nesta execução\n"
+        << "# TYPE find_seed_phrases_total counter\n";
+    for (size_t i = 0; i < names_.size(); i++) {
+        const StageCounters& now = sample.devices[i];
+        const std::pair<const char*, uint64_t> stages[] = {
+            {"enumerated", now.enumerated},
+            {"repeated", now.enumerated - now.distinct},
+            {"checksum_rejected", now.distinct - now.accepted},
+            {"pbkdf2", now.seeds}};
+        for (const auto& stage : stages) {
+            out << "find_seed_phrases_total{" << labels(i) << ",stage=\"" << stage.first
+                << "\"} " << stage.second << "\n";
+        }
+    }
+
+    out << "# HELP find_seed_keys_total Chaves públicas comparadas com os alvos\n"
+        << "# TYPE find_seed_keys_total counter\n";
+    for (size_t i = 0; i < names_.size(); i++) {
+        out << "find_seed_keys_total{" << labels(i) << "} " << sample.devices[i].keys << "\n";
+    }
+
+    out << "# HELP find_seed_hits_total Acertos do kernel a confirmar no host\n"
+        << "# TYPE find_seed_hits_total counter\n";
+    for (size_t i = 0; i < names_.size(); i++) {
+        out << "find_seed_hits_total{" << labels(i) << "} " << sample.devices[i].hits << "\n";
+    }
+
+    out << "# HELP find_seed_rate Média por segundo na janela de telemetria\n"
+        << "# TYPE find_seed_rate gauge\n";
+    for (size_t i = 0; i < names_.size(); i++) {
+        const StageCounters& now = sample.devices[i];
+        const StageCounters& before = oldest.devices[i];
+        out << "find_seed_rate{" << labels(i) << ",stage=\"enumerated\"} "
+            << per_second(now.enumerated, before.enumerated, span) << "\n"
+            << "find_seed_rate{" << labels(i) << ",stage=\"pbkdf2\"} "
+            << per_second(now.seeds, before.seeds, span) << "\n"
+            << "find_seed_rate{" << labels(i) << ",stage=\"keys\"} "
+            << per_second(now.keys, before.keys, span) << "\n";
+    }
+
+    out << "# HELP find_seed_completed_ranks Ranks concluídos, incluindo os do journal\n"
+        << "# TYPE find_seed_completed_ranks gauge\n"
+        << "find_seed_completed_ranks " << completed << "\n"
+        << "# HELP find_seed_total_ranks Ranks do espaço de busca\n"
+        << "# TYPE find_seed_total_ranks gauge\n"
+        << "find_seed_total_ranks " << total << "\n"
+        << "# HELP find_seed_eta_seconds Tempo restante estimado pela taxa da janela\n"
+        << "# TYPE find_seed_eta_seconds gauge\n"
+        << "find_seed_eta_seconds ";
+    if (rate > 0.0) {
+        out << static_cast<double>(total - completed) / rate << "\n";
+    } else {
+        out << "NaN\n";
+    }
+
+    // O collector nunca vê um arquivo pela metade: gravar ao lado e renomear
+    const std::string tmp_path = prom_path_ + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        file << out.str();
+        file.close();
+        if (!file) {
+            throw std::runtime_error("Erro ao gravar " + tmp_path);
+        }
+    }
+    std::filesystem::rename(tmp_path, prom_path_);
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "work_scheduler.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Frases de um lote em cada estágio do pipeline: contadores do kernel
+// (STATUS_DISTINCT a STATUS_KEYS em bip39.cl) ou do motor de CPU
+struct StageCounters {
+    uint64_t enumerated = 0;   // ranks cobertos
+    uint64_t distinct = 0;     // sem palavra repetida
+    uint64_t accepted = 0;     // aprovadas no checksum (entram no PBKDF2)
+    uint64_t seeds = 0;        // PBKDF2 concluídos
+    uint64_t keys = 0;         // chaves públicas comparadas com os alvos
+    uint64_t hits = 0;         // acertos a confirmar no host
+
+    StageCounters& operator+=(const StageCounters& other);
+};
+
+// Telemetria da busca para monitoramento externo. Os workers somam os
+// contadores de cada lote concluído; uma thread grava a cada `interval`
+// segundos, por dispositivo, os totais, as taxas médias da janela de
+// `window` segundos e o ETA: uma linha JSON acrescentada a json_path e um
+// textfile do Prometheus em prom_path (reescrito com rename, para o textfile
+// collector do node_exporter). Caminho vazio desliga a saída. Workers
+// seguidos com o mesmo nome (threads do motor de CPU) são um dispositivo,
+// como no relatório do console.
+class Telemetry {
+public:
+    // Lança std::runtime_error se json_path não puder ser aberto
+    Telemetry(const WorkScheduler& scheduler, const std::vector<std::string>& workers,
+              const std::string& json_path, const std::string& prom_path,
+              double interval = 10.0, double window = 60.0);
+    ~Telemetry();
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    // Contadores de um lote concluído pelo worker (chamado pelas threads dos
+    // workers)
+    void add(size_t worker, const StageCounters& counters);
+
+    // Grava uma última amostra e encerra a thread
+    void stop();
+
+private:
+    struct Sample {
+        double seconds = 0.0;                 // desde a criação
+        std::vector<StageCounters> devices;   // totais acumulados
+    };
+
+    void loop();
+    void write(const Sample& sample);
+    void write_json(const Sample& sample, const Sample& oldest, uint64_t completed);
+    void write_prometheus(const Sample& sample, const Sample& oldest, uint64_t completed);
+
+    const WorkScheduler& scheduler_;
+    std::vector<std::string> names_;     // nome de cada dispositivo
+    std::vector<size_t> threads_of_;     // workers de cada dispositivo
+    std::vector<size_t> device_of_;      // dispositivo de cada worker
+    std::string prom_path_;
+    std::ofstream json_;
+    double interval_;
+    double window_;
+    std::chrono::steady_clock::time_point start_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::vector<StageCounters> totals_;   // por dispositivo, protegido por mutex_
+
+    std::deque<Sample> history_;          // amostras da janela (só a thread)
+    bool warned_ = false;
+    std::thread thread_;
+};
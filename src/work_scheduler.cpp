@@ -0,0 +1,173 @@
+#include "work_scheduler.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+WorkScheduler::WorkScheduler(uint64_t begin, uint64_t end, size_t device_count,
+                             double chunk_seconds, uint64_t min_chunk)
+    : WorkScheduler(begin, end, {RankRange{begin, end}}, device_count,
+                    chunk_seconds, min_chunk) {}
+
+WorkScheduler::WorkScheduler(uint64_t begin, uint64_t end,
+                             const std::vector<RankRange>& remaining,
+                             size_t device_count, double chunk_seconds,
+                             uint64_t min_chunk)
+    : total_(end - begin), completed_(end - begin), chunk_seconds_(chunk_seconds),
+      min_chunk_(min_chunk), devices_(device_count) {
+    if (begin > end) {
+        throw std::invalid_argument("Intervalo de ranks inválido");
+    }
+    if (device_count == 0) {
+        throw std::invalid_argument("Nenhum dispositivo para o escalonador");
+    }
+
+    for (const auto& range : remaining) {
+        if (range.begin < begin || range.end > end) {
+            throw std::invalid_argument("Intervalo restante fora do espaço de busca");
+        }
+        if (!range.empty()) {
+            pending_.push_back(range);
+            completed_ -= range.size();
+        }
+    }
+}
+
+uint64_t WorkScheduler::chunk_size(const DeviceState& state) const {
+    // Sem medição ainda: bloco mínimo serve como calibração
+    if (state.rate <= 0.0) {
+        return min_chunk_;
+    }
+    double size = state.rate * chunk_seconds_;
+    return std::max<uint64_t>(min_chunk_, static_cast<uint64_t>(size));
+}
+
+bool WorkScheduler::take_from_pool(DeviceState& state) {
+    if (pending_.empty()) {
+        return false;
+    }
+
+    RankRange& front = pending_.front();
+    uint64_t size = std::min(chunk_size(state), front.size());
+    state.assigned = {front.begin, front.begin + size};
+    front.begin += size;
+    if (front.empty()) {
+        pending_.pop_front();
+    }
+    return true;
+}
+
+bool WorkScheduler::steal(size_t thief) {
+    // Vítima: dispositivo com mais trabalho atribuído e ainda não iniciado
+    size_t victim = devices_.size();
+    uint64_t largest = 1;
+    for (size_t i = 0; i < devices_.size(); i++) {
+        if (i != thief && devices_[i].assigned.size() > largest) {
+            largest = devices_[i].assigned.size();
+            victim = i;
+        }
+    }
+    if (victim == devices_.size()) {
+        return false;
+    }
+
+    DeviceState& from = devices_[victim];
+    DeviceState& to = devices_[thief];
+
+    // Dividir o restante na proporção das vazões (metade se ainda não medidas)
+    double share = 0.5;
+    if (!from.retired && from.rate > 0.0 && to.rate > 0.0) {
+        share = to.rate / (to.rate + from.rate);
+    } else if (from.retired) {
+        share = 1.0;
+    }
+
+    uint64_t remaining = from.assigned.size();
+    uint64_t amount = std::max<uint64_t>(1, static_cast<uint64_t>(remaining * share));
+    amount = std::min(amount, remaining);
+
+    to.assigned = {from.assigned.end - amount, from.assigned.end};
+    from.assigned.end -= amount;
+    to.steals++;
+    return true;
+}
+
+bool WorkScheduler::next_batch(size_t device, uint64_t max_batch, RankRange& batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DeviceState& state = devices_.at(device);
+
+    if (state.retired) {
+        return false;
+    }
+
+    if (state.assigned.empty() && !take_from_pool(state) && !steal(device)) {
+        return false;
+    }
+
+    uint64_t size = std::min(max_batch, state.assigned.size());
+    batch = {state.assigned.begin, state.assigned.begin + size};
+    state.assigned.begin += size;
+    return true;
+}
+
+void WorkScheduler::report(size_t device, uint64_t tested, double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DeviceState& state = devices_.at(device);
+
+    state.tested += tested;
+    completed_ += tested;
+
+    if (seconds > 0.0) {
+        double measured = tested / seconds;
+        state.rate = (state.rate <= 0.0) ? measured : 0.7 * state.rate + 0.3 * measured;
+    }
+}
+
+void WorkScheduler::release(const RankRange& batch) {
+    if (batch.empty()) {
+        return;
+    }
+    // Lotes devolvidos têm prioridade sobre o restante do pool
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_front(batch);
+}
+
+void WorkScheduler::retire(size_t device) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DeviceState& state = devices_.at(device);
+    state.retired = true;
+    if (!state.assigned.empty()) {
+        pending_.push_front(state.assigned);
+        state.assigned = {};
+    }
+}
+
+double WorkScheduler::rate(size_t device) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const DeviceState& state = devices_.at(device);
+    return state.retired ? 0.0 : state.rate;
+}
+
+double WorkScheduler::total_rate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double total = 0.0;
+    for (const auto& state : devices_) {
+        if (!state.retired) {
+            total += state.rate;
+        }
+    }
+    return total;
+}
+
+uint64_t WorkScheduler::tested(size_t device) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return devices_.at(device).tested;
+}
+
+uint64_t WorkScheduler::steals(size_t device) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return devices_.at(device).steals;
+}
+
+uint64_t WorkScheduler::completed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Intervalo semiaberto de ranks [begin, end)
+struct RankRange {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+
+    uint64_t size() const { return end - begin; }
+    bool empty() const { return begin >= end; }
+};
+
+// Distribui o espaço de ranks entre os dispositivos. Cada dispositivo recebe
+// blocos proporcionais à sua vazão medida e consome o bloco em lotes; quando o
+// espaço global acaba, um dispositivo ocioso toma parte do bloco restante de
+// outro (proporcional às vazões), então os rápidos terminam o trabalho dos
+// lentos no fim do intervalo.
+class WorkScheduler {
+public:
+    WorkScheduler(uint64_t begin, uint64_t end, size_t device_count,
+                  double chunk_seconds = 10.0, uint64_t min_chunk = 1ULL << 20);
+
+    // Retomada: apenas os intervalos `remaining` de [begin, end) são
+    // distribuídos; o resto conta como já concluído
+    WorkScheduler(uint64_t begin, uint64_t end, const std::vector<RankRange>& remaining,
+                  size_t device_count, double chunk_seconds = 10.0,
+                  uint64_t min_chunk = 1ULL << 20);
+
+    // Próximo lote do dispositivo com no máximo max_batch ranks.
+    // Retorna false quando não há mais trabalho em nenhum lugar.
+    bool next_batch(size_t device, uint64_t max_batch, RankRange& batch);
+
+    // Registrar um lote concluído e o tempo gasto nele
+    void report(size_t device, uint64_t tested, double seconds);
+
+    // Devolver um lote que não foi processado (erro no dispositivo)
+    void release(const RankRange& batch);
+
+    // Dispositivo parou: o restante do bloco dele volta para o pool
+    void retire(size_t device);
+
+    size_t device_count() const { return devices_.size(); }
+    double rate(size_t device) const;
+    double total_rate() const;
+    uint64_t tested(size_t device) const;
+    uint64_t steals(size_t device) const;
+    uint64_t completed() const;
+    uint64_t total() const { return total_; }
+
+private:
+    struct DeviceState {
+        RankRange assigned;
+        double rate = 0.0;       // ranks/s (média móvel exponencial)
+        uint64_t tested = 0;
+        uint64_t steals = 0;
+        bool retired = false;
+    };
+
+    uint64_t chunk_size(const DeviceState& state) const;
+    bool take_from_pool(DeviceState& state);
+    bool steal(size_t thief);
+
+    mutable std::mutex mutex_;
+    uint64_t total_;
+    uint64_t completed_;
+    double chunk_seconds_;
+    uint64_t min_chunk_;
+    std::deque<RankRange> pending_;   // trabalho ainda não atribuído
+    std::vector<DeviceState> devices_;
+};